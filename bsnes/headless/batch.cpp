@@ -0,0 +1,156 @@
+//batch mode: runs a list of cartridge + movie jobs and reports the final state
+//hash and timing of each. the core keeps all emulator state in globals, so one
+//process hosts exactly one console: jobs run in forked worker processes, which
+//also keeps a crashing job from taking the rest of the batch down with it.
+
+struct Job {
+  string cartridge;
+  string movie;
+  unsigned frames;
+};
+
+struct JobResult {
+  bool ok;
+  unsigned frames;
+  double seconds;
+  uint32_t hash;
+};
+
+static bool is_number(const string &field) {
+  if(field == "") return false;
+  for(unsigned n = 0; n < field.length(); n++) {
+    if(field[n] < '0' || field[n] > '9') return false;
+  }
+  return true;
+}
+
+//one job per line: cartridge [movie] [frames]. fields are separated by spaces;
+//paths that contain spaces must be quoted. blank lines and # comments are skipped.
+//only a field made of digits alone is a frame count, so "2020-run.bsv" is a movie.
+static bool read_jobs(const char *filename, std::vector<Job> &jobs) {
+  string text;
+  if(text.readfile(filename) == false) return false;
+  text.replace("\r", "");
+
+  lstring lines;
+  lines.split("\n", text);
+  for(unsigned i = 0; i < lines.size(); i++) {
+    string line = lines[i];
+    line.trim();
+    if(line == "" || line[0] == '#') continue;
+
+    lstring fields;
+    fields.qsplit(" ", line);
+    Job job = { "", "", 0 };
+    for(unsigned n = 0; n < fields.size(); n++) {
+      string field = fields[n];
+      field.trim<1>("\"");
+      if(field == "") continue;
+      if(job.cartridge == "") job.cartridge = field;
+      else if(is_number(field)) job.frames = decimal(field);
+      else job.movie = field;
+    }
+    jobs.push_back(job);
+  }
+  return true;
+}
+
+//runs inside the worker process
+static JobResult run_job(const Job &job) {
+  JobResult result = { false, 0, 0.0, 0 };
+  SNES::config().random = false;
+  SNES::system.init(&interface);
+
+  if(load_cartridge(job.cartridge) == false) return result;
+  if(job.movie != "" && load_movie(job.movie) == false) return result;
+  unsigned frames = job.frames;
+  if(frames == 0 && interface.playback == false) frames = 600;
+
+  Clock::time_point start = Clock::now();
+  while(frames ? result.frames < frames : interface.playback) {
+    SNES::system.run();
+    result.frames++;
+  }
+  result.seconds = elapsed(start, Clock::now());
+  result.hash = state_hash();
+  result.ok = true;
+  return result;
+}
+
+#if !defined(_WIN32)
+#include <unistd.h>
+#include <sys/wait.h>
+
+static int run_batch(const char *filename, unsigned workers) {
+  std::vector<Job> jobs;
+  if(read_jobs(filename, jobs) == false) {
+    print("error: unable to read job list ", filename, "\n");
+    return 1;
+  }
+  if(workers == 0) workers = max(1, (int)sysconf(_SC_NPROCESSORS_ONLN));
+
+  struct Worker {
+    pid_t pid;
+    int pipe;
+    unsigned job;
+  };
+  std::vector<Worker> active;
+  std::vector<JobResult> results(jobs.size());
+  unsigned next = 0, failed = 0;
+  uint64_t frames = 0;
+  fflush(stdout);
+
+  Clock::time_point start = Clock::now();
+  while(next < jobs.size() || active.size()) {
+    while(next < jobs.size() && active.size() < workers) {
+      int channel[2];
+      if(pipe(channel) != 0) { print("error: pipe() failed\n"); return 1; }
+      pid_t pid = fork();
+      if(pid < 0) { print("error: fork() failed\n"); return 1; }
+      if(pid == 0) {
+        close(channel[0]);
+        JobResult result = run_job(jobs[next]);
+        ssize_t written = write(channel[1], &result, sizeof result);
+        _exit(written == sizeof result ? 0 : 1);
+      }
+      close(channel[1]);
+      Worker worker = { pid, channel[0], next++ };
+      active.push_back(worker);
+    }
+
+    int status;
+    pid_t pid = wait(&status);
+    if(pid < 0) break;
+    for(unsigned i = 0; i < active.size(); i++) {
+      if(active[i].pid != pid) continue;
+      JobResult &result = results[active[i].job];
+      if(read(active[i].pipe, &result, sizeof result) != sizeof result) result.ok = false;
+      close(active[i].pipe);
+
+      const Job &job = jobs[active[i].job];
+      if(result.ok) {
+        frames += result.frames;
+        printf("%5u  %8u %9.3fs %9.2f fps  %.8x  %s %s\n", active[i].job, result.frames, result.seconds,
+          result.seconds ? result.frames / result.seconds : 0.0, result.hash,
+          (const char*)job.cartridge, (const char*)job.movie);
+      } else {
+        failed++;
+        printf("%5u  failed  %s %s\n", active[i].job, (const char*)job.cartridge, (const char*)job.movie);
+      }
+      fflush(stdout);
+      active.erase(active.begin() + i);
+      break;
+    }
+  }
+  double total = elapsed(start, Clock::now());
+
+  printf("batch:      %u jobs (%u failed) on %u workers in %.3fs\n", (unsigned)jobs.size(), failed, workers, total);
+  printf("throughput: %.2f frames/s, %.1f jobs/hour\n", frames / total, jobs.size() * 3600.0 / total);
+  return failed ? 2 : 0;
+}
+#else
+static int run_batch(const char *filename, unsigned workers) {
+  print("error: --batch requires fork(), which is not available on this platform\n");
+  return 1;
+}
+#endif
@@ -0,0 +1,82 @@
+#!/bin/sh
+# runs pairs of headless builds or modes that must agree, and reports each
+# comparison as ok or FAIL. `make headless-check` builds the variants first.
+#   headless/check.sh [--frames n] file.sfc|file.spc ...
+# the binaries are taken from $out (default: out).
+
+out=${out:-out}
+frames=600
+if [ "$1" = "--frames" ]; then frames=$2; shift 2; fi
+if [ $# -eq 0 ]; then
+  echo "usage: headless/check.sh [--frames n] file.sfc|file.spc ..."
+  exit 1
+fi
+
+status=0
+
+#run profile file [options]: prints the runner's report
+run() {
+  binary=$out/bsnes-headless-$1
+  file=$2
+  shift 2
+  case "$file" in
+    *.spc) "$binary" --frames $frames "$@" --spc "$file" ;;
+    *)     "$binary" --frames $frames "$@" "$file" ;;
+  esac
+}
+
+#hash name report: prints the crc32 on the report's "name:" line
+hash() {
+  echo "$2" | sed -n "s/^$1: *crc32 \([0-9a-f]*\).*/\1/p"
+}
+
+#same description a b
+same() {
+  if [ -n "$2" ] && [ "$2" = "$3" ]; then
+    echo "ok    $1"
+  else
+    echo "FAIL  $1: ${2:-no result} vs ${3:-no result}"
+    status=1
+  fi
+}
+
+for file in "$@"; do
+  #the blocked S-DSP catches up before everything that observes it, so it
+  #outputs the same samples as the cothread resumed on every S-SMP cycle
+  blocked=$(hash audio "$(run accuracy "$file")")
+  threaded=$(hash audio "$(run accuracy-threaded "$file")")
+  same "$file: S-DSP audio, blocked vs threaded" "$blocked" "$threaded"
+
+  #a keyframe plus a delta loads as the full savestate taken at the same point
+  report=$(run performance "$file" --delta-check 60)
+  same "$file: savestate, keyframe plus delta vs full" "$(hash delta "$report")" "$(hash full "$report")"
+  same "$file: stale and truncated deltas" rejected "$(echo "$report" | sed -n "s/^stale and truncated deltas: //p")"
+
+  #frames handed to the presentation thread keep the lines above the frame
+  #that a PAL TV shows; any read outside the copy stops the sanitized build
+  case "$file" in *.spc) continue ;; esac
+  direct=$(hash video "$(run performance-asan "$file" --video-hash pal)")
+  presented=$(hash video "$(run performance-asan "$file" --video-hash pal --present-thread)")
+  same "$file: PAL TV picture, direct vs presentation thread" "$direct" "$presented"
+
+  #on SuperFX carts, every pixel cache row written out converts to the same
+  #bitplanes with the lookup table as pixel by pixel
+  rows=$(mktemp)
+  run performance "$file" --plot-record "$rows" > /dev/null
+  replay=""
+  if [ -s "$rows" ]; then replay=$("$out/bsnes-headless-performance" --plot-replay "$rows"); fi
+  if echo "$replay" | grep -q "rows differ"; then
+    differ=$(echo "$replay" | sed -n "s/.* \([0-9]*\) rows differ$/\1/p")
+    same "$file: SuperFX bitplanes, rows that differ from per-pixel conversion" 0 "$differ"
+  fi
+  rm -f "$rows"
+
+  #on DSP-1 carts, the DSP-1 HLE must answer every DR read as the firmware does
+  verify=$(run performance "$file" --dsp1 verify)
+  if echo "$verify" | grep -q "^dsp1:"; then
+    result=$(echo "$verify" | sed -n "s/^dsp1: *verify, \([0-9]*\) DR reads, \(.*\)/\2/p")
+    same "$file: DSP-1 DR reads, HLE vs firmware" "no difference" "$result"
+  fi
+done
+
+exit $status
@@ -0,0 +1,507 @@
+#include <snes.hpp>
+
+#include <nall/crc32.hpp>
+#include <nall/snes/cartridge.hpp>
+using namespace nall;
+
+#include <algorithm>
+#include <chrono>
+#include <vector>
+
+//bsnes-headless: runs the emulation core with a null interface (no Qt, no ruby)
+//and reports throughput statistics. one binary is built per profile.
+
+struct Interface : public SNES::Interface {
+  file movie;
+  bool playback;
+  unsigned skipped;
+  uint32_t audiocrc;
+  unsigned samples;
+  enum class TV : unsigned { None, NTSC, PAL } tv;
+  uint32_t videocrc;
+  unsigned pictures;
+
+  //input log uses the ui-qt movie format (.bsv): one 16-bit value per poll
+  int16_t input_poll(bool port, SNES::Input::Device device, unsigned index, unsigned id) {
+    if(playback == false) return 0;
+    int16_t result = movie.readl(2);
+    if(movie.end()) {
+      playback = false;
+      movie.close();
+    }
+    return result;
+  }
+
+  void video_frameskip(unsigned skipped) {
+    this->skipped = skipped;
+  }
+
+  //hash of the lines a TV shows, cropped from the frame as ui-qt does: a PAL display
+  //starts 7 lines above a frame that is not overscanned, and reads 239 lines
+  void video_refresh(const uint16_t *data, unsigned width, unsigned height) {
+    if(tv == TV::None) return;
+    bool interlace = (height >= 240);
+    bool overscan = (height == 239 || height == 478);
+    unsigned pitch = interlace ? 512 : 1024;
+
+    if(tv == TV::NTSC) {
+      height = 224;
+      if(overscan) data += 7 * 1024;
+    } else {
+      height = 239;
+      if(!overscan) data -= 7 * 1024;
+    }
+    if(interlace) height <<= 1;
+
+    for(unsigned y = 0; y < height; y++) {
+      const uint16_t *line = data + y * pitch;
+      for(unsigned x = 0; x < width; x++) {
+        videocrc = crc32_adjust(videocrc, line[x]);
+        videocrc = crc32_adjust(videocrc, line[x] >> 8);
+      }
+    }
+    pictures++;
+  }
+
+  //hash of every sample since power-on, to compare audio output across builds
+  void audio_sample(uint16_t left, uint16_t right) {
+    uint8_t data[4] = { (uint8_t)left, (uint8_t)(left >> 8), (uint8_t)right, (uint8_t)(right >> 8) };
+    for(unsigned n = 0; n < 4; n++) audiocrc = crc32_adjust(audiocrc, data[n]);
+    samples++;
+  }
+
+  Interface() : playback(false), skipped(0), audiocrc(~0), samples(0), tv(TV::None), videocrc(~0), pictures(0) {}
+};
+
+static Interface interface;
+
+typedef std::chrono::steady_clock Clock;
+
+static double elapsed(Clock::time_point start, Clock::time_point end) {
+  return std::chrono::duration<double>(end - start).count();
+}
+
+static bool load_cartridge(const char *filename) {
+  file fp;
+  if(fp.open(filename, file::mode::read) == false) return false;
+  unsigned size = fp.size();
+  uint8_t *data = new uint8_t[size];
+  fp.read(data, size);
+  fp.close();
+
+  //remove copier header, if it exists
+  if((size & 0x7fff) == 512) memmove(data, data + 512, size -= 512);
+
+  string xml;
+  string xmlname = string(nall::basename(filename), ".xml");
+  if(file::exists(xmlname)) {
+    xml.readfile(xmlname);
+  } else {
+    xml = SNESCartridge(data, size).xmlMemoryMap;
+  }
+
+  SNES::cartridge.basename = nall::basename(filename);
+  SNES::memory::cartrom.copy(data, size);
+  delete[] data;
+
+  SNES::cartridge.load(SNES::Cartridge::Mode::Normal, { xml });
+  SNES::system.power();
+  return true;
+}
+
+//SPC700 sound file: the S-SMP and S-DSP run from the dump while the S-CPU is halted
+//on a dummy cartridge, as in ui-qt
+static bool load_spc(const char *filename) {
+  file fp;
+  if(fp.open(filename, file::mode::read) == false) return false;
+  if(fp.size() < 0x10180) return false;
+  uint8_t *data = new uint8_t[0x10180];
+  fp.read(data, 0x10180);
+  fp.close();
+
+  uint16_t pc = data[0x25] | data[0x26] << 8;
+  uint8_t regs[4] = { data[0x27], data[0x28], data[0x29], data[0x2b] };  //a, x, y, sp
+  uint8_t p = data[0x2a];
+
+  SNES::cartridge.basename = nall::basename(filename);
+  string xml = "<cartridge region='NTSC' />";
+  SNES::cartridge.load(SNES::Cartridge::Mode::Normal, { xml });
+  SNES::system.power();
+  SNES::smp.load_dump(data + 0x100, pc, regs, p);
+  SNES::memory::wram[0] = 0xdb;  //STP
+  SNES::cpu.regs.pc = 0;
+  delete[] data;
+  return true;
+}
+
+static bool load_movie(const char *filename) {
+  file &fp = interface.movie;
+  if(fp.open(filename, file::mode::read) == false) return false;
+
+  if(fp.size() >= 32
+  && fp.readm(4) == 0x42535631
+  && fp.readl(4) == SNES::Info::SerializerVersion
+  && fp.readl(4) == SNES::cartridge.crc32()) {
+    unsigned size = fp.readl(4);
+    uint8_t *data = new uint8_t[size];
+    fp.read(data, size);
+    serializer state(data, size);
+    delete[] data;
+    if(SNES::system.unserialize(state)) {
+      interface.playback = !fp.end();
+      return true;
+    }
+  }
+
+  fp.close();
+  return false;
+}
+
+//crc32 of the savestate, without the components that depend on the host rather
+//than on emulation: the random seed (unused while config().random is off), the
+//wall clock of the BS-X base unit, and the header, which counts the savestates
+//taken so far. identical runs hash identically.
+static uint32_t state_hash() {
+  serializer state = SNES::system.serialize();
+  uint32_t crc32 = ~0;
+  for(unsigned i = 0; i < SNES::system.state_regions; i++) {
+    const SNES::System::StateRegion &region = SNES::system.state_region[i];
+    if(!strcmp(region.name, "random") || !strcmp(region.name, "bsxbase") || !strcmp(region.name, "header")) continue;
+    for(unsigned n = 0; n < region.size; n++) crc32 = crc32_adjust(crc32, state.data()[region.offset + n]);
+  }
+  return ~crc32;
+}
+
+#if defined(DEBUGGER)
+//--plot-record: called before each SuperFX opcode, writes the pixel cache rows the
+//previous opcode wrote out to game RAM. PLOT writes the second row when it replaces
+//it, and RPIX writes both rows and leaves them empty.
+static void plot_record(SNES::SuperFX::pixelcache_t (&last)[2], file &record) {
+  const SNES::SuperFX::pixelcache_t *cache = SNES::superfx.pixelcache;
+  auto same = [](const SNES::SuperFX::pixelcache_t &a, const SNES::SuperFX::pixelcache_t &b) {
+    return a.offset == b.offset && a.bitpend == b.bitpend && memcmp(a.data, b.data, 8) == 0;
+  };
+  if(last[1].bitpend && !same(last[1], cache[1])) record.write(last[1].data, 8);
+  if(last[0].bitpend && !cache[0].bitpend && !cache[1].bitpend) record.write(last[0].data, 8);
+  last[0] = cache[0];
+  last[1] = cache[1];
+}
+#endif
+
+//SuperFX pixel cache rows, as written by --plot-record: the eight colors of each row.
+//every row is converted to bitplanes with the lookup table, timed, and checked
+//against a pixel-by-pixel conversion
+static int plot_replay(const char *filename) {
+  file fp;
+  if(fp.open(filename, file::mode::read) == false) {
+    print("error: unable to load pixel cache rows ", filename, "\n");
+    return 1;
+  }
+  unsigned count = fp.size() / 8;
+  std::vector<SNES::SuperFX::pixelcache_t> rows(count);
+  for(unsigned n = 0; n < count; n++) fp.read(rows[n].data, 8);
+  fp.close();
+  if(count == 0) {
+    print("error: ", filename, " holds no pixel cache rows\n");
+    return 1;
+  }
+
+  SNES::system.init(&interface);
+  std::vector<uint64_t> planes(count);
+  unsigned passes = max(1u, 4000000u / count);
+
+  Clock::time_point begin = Clock::now();
+  for(unsigned pass = 0; pass < passes; pass++) {
+    for(unsigned n = 0; n < count; n++) planes[n] = SNES::superfx.pixelcache_planes(rows[n]);
+  }
+  double table = elapsed(begin, Clock::now()) * 1000000000.0 / ((double)passes * count);
+
+  unsigned differ = 0;
+  for(unsigned n = 0; n < count; n++) {
+    uint64_t expected = 0;
+    for(unsigned plane = 0; plane < 8; plane++) {
+      for(unsigned x = 0; x < 8; x++) expected |= (uint64_t)((rows[n].data[x] >> plane) & 1) << (plane * 8 + x);
+    }
+    differ += planes[n] != expected;
+  }
+  printf("plot:       %u rows, table %.2f ns/row, %u rows differ\n", count, table, differ);
+  return differ ? 1 : 0;
+}
+
+#include "batch.cpp"
+
+static void usage() {
+  print("usage: bsnes-headless-<profile> [options] cartridge.sfc\n");
+  print("       bsnes-headless-<profile> [options] --spc file.spc\n");
+  print("       bsnes-headless-<profile> --batch file [--jobs n]\n");
+  print("  --frames n     number of frames to measure (default: 600, or until the movie ends)\n");
+  print("  --warmup n     number of frames to run before measuring (default: 0)\n");
+  print("  --movie file   play back input from a .bsv movie recorded with the same profile\n");
+  print("  --profile      report host time and context switches per processor\n");
+  print("  --relaxed-sync skip the S-CPU/S-SMP lock-step between port accesses\n");
+  print("  --sync-window n let the NEC DSP and Cx4 run up to n clocks ahead of the S-CPU\n");
+  print("  --dsp1 mode    DSP-1 emulation: lle (default), hle, or verify (run both, fail if they differ)\n");
+  print("  --no-video     keep PPU timing and state exact, but draw no pixels\n");
+  print("  --frameskip n  draw one frame, then skip n (profiles with SupportsFrameSkip)\n");
+  print("  --render-thread draw scanlines on a second thread (profiles with SupportsRenderThread)\n");
+  print("  --present-thread present frames on a second thread while the next one runs\n");
+  print("  --video-hash tv report a hash of the lines an ntsc or pal TV shows of each frame\n");
+  print("  --savestate n  capture a savestate every n frames and report its latency\n");
+  print("  --roundtrips n after the run, time n savestate save+load round trips\n");
+  print("  --delta-check n after the run, save a state, run n frames, and check that the\n");
+  print("                 state plus a delta savestate loads as the full savestate does\n");
+  print("  --spc file     play an SPC700 sound file instead of a cartridge\n");
+  print("  --plot-record file  save every SuperFX pixel cache row written to game RAM\n");
+  print("  --plot-replay file  convert saved rows to bitplanes, check and time the conversion\n");
+  print("  --batch file   run every job in file (one 'cartridge [movie] [frames]' per line)\n");
+  print("  --jobs n       number of worker processes for --batch (default: one per core)\n");
+}
+
+int main(int argc, char **argv) {
+  const char *cartname = 0;
+  const char *moviename = 0;
+  const char *spcname = 0;
+  unsigned frames = 0;
+  unsigned warmup = 0;
+  unsigned savestate = 0;
+  unsigned roundtrips = 0;
+  unsigned deltaframes = 0;
+  const char *batchname = 0;
+  unsigned workers = 0;
+  unsigned frameskip = 0;
+  bool profile = false;
+  const char *recordname = 0;
+  const char *replayname = 0;
+
+  for(int i = 1; i < argc; i++) {
+    string arg = argv[i];
+    if(arg == "--frames" && i + 1 < argc) frames = decimal(argv[++i]);
+    else if(arg == "--warmup" && i + 1 < argc) warmup = decimal(argv[++i]);
+    else if(arg == "--movie" && i + 1 < argc) moviename = argv[++i];
+    else if(arg == "--profile") profile = true;
+    else if(arg == "--relaxed-sync") SNES::config().smp.relaxed_sync = true;
+    else if(arg == "--sync-window" && i + 1 < argc) SNES::config().coprocessor.sync_window = decimal(argv[++i]);
+    else if(arg == "--dsp1" && i + 1 < argc) SNES::config().coprocessor.dsp1 = argv[++i];
+    else if(arg == "--no-video") SNES::system.set_render_video(false);
+    else if(arg == "--frameskip" && i + 1 < argc) frameskip = decimal(argv[++i]);
+    else if(arg == "--render-thread") SNES::config().ppu2.render_thread = true;
+    else if(arg == "--present-thread") SNES::video.set_present_thread(true);
+    else if(arg == "--video-hash" && i + 1 < argc) {
+      string tv = argv[++i];
+      if(tv == "ntsc") interface.tv = Interface::TV::NTSC;
+      else if(tv == "pal") interface.tv = Interface::TV::PAL;
+      else { usage(); return 1; }
+    }
+    else if(arg == "--savestate" && i + 1 < argc) savestate = decimal(argv[++i]);
+    else if(arg == "--roundtrips" && i + 1 < argc) roundtrips = decimal(argv[++i]);
+    else if(arg == "--delta-check" && i + 1 < argc) deltaframes = decimal(argv[++i]);
+    else if(arg == "--spc" && i + 1 < argc) spcname = argv[++i];
+    else if(arg == "--plot-record" && i + 1 < argc) recordname = argv[++i];
+    else if(arg == "--plot-replay" && i + 1 < argc) replayname = argv[++i];
+    else if(arg == "--batch" && i + 1 < argc) batchname = argv[++i];
+    else if(arg == "--jobs" && i + 1 < argc) workers = decimal(argv[++i]);
+    else if(argv[i][0] != '-' && !cartname) cartname = argv[i];
+    else { usage(); return 1; }
+  }
+  if(batchname) return run_batch(batchname, workers);
+  if(replayname) return plot_replay(replayname);
+  if(!cartname == !spcname) { usage(); return 1; }
+
+  //keep runs reproducible
+  SNES::config().random = false;
+  SNES::system.init(&interface);
+
+  if(spcname) {
+    if(load_spc(spcname) == false) {
+      print("error: unable to load SPC file ", spcname, "\n");
+      return 1;
+    }
+    cartname = spcname;
+  } else if(load_cartridge(cartname) == false) {
+    print("error: unable to load cartridge ", cartname, "\n");
+    return 1;
+  }
+  file record;
+  #if defined(DEBUGGER)
+  SNES::SuperFX::pixelcache_t recorded[2] = {};
+  #endif
+  if(recordname) {
+    #if defined(DEBUGGER)
+    if(record.open(recordname, file::mode::write) == false) {
+      print("error: unable to create ", recordname, "\n");
+      return 1;
+    }
+    SNES::superfx.step_event = [&] { plot_record(recorded, record); };
+    #else
+    print("error: --plot-record needs a build with DEBUGGER defined\n");
+    return 1;
+    #endif
+  }
+  if(moviename && load_movie(moviename) == false) {
+    print("error: movie ", moviename, " is invalid for this cartridge and profile\n");
+    return 1;
+  }
+  if(frames == 0 && interface.playback == false) frames = 600;
+  if(frameskip) {
+    if(SNES::PPU::SupportsFrameSkip == false) {
+      print("error: the ", SNES::Info::Profile, " profile does not support --frameskip\n");
+      return 1;
+    }
+    SNES::ppu.set_frameskip(frameskip + 1);
+  }
+  if(SNES::config().ppu2.render_thread && SNES::PPU::SupportsRenderThread == false) {
+    print("error: the ", SNES::Info::Profile, " profile does not support --render-thread\n");
+    return 1;
+  }
+
+  for(unsigned n = 0; n < warmup; n++) SNES::system.run();
+
+  //slot 0 is the host thread; every emulated processor follows
+  SNES::Profiler &profiler = SNES::profiler;
+  std::vector<uint64_t> cycles;
+  for(unsigned i = 1; i < profiler.slots; i++) cycles.push_back(profiler.processor[i]->cycles);
+  profiler.enable(profile);
+
+  std::vector<double> frametime, savetime;
+  Clock::time_point start = Clock::now();
+  while(frames ? frametime.size() < frames : interface.playback) {
+    Clock::time_point begin = Clock::now();
+    SNES::system.run();
+    if(savestate && (frametime.size() + 1) % savestate == 0) {
+      Clock::time_point save = Clock::now();
+      SNES::system.runtosave();
+      serializer state = SNES::system.serialize();
+      savetime.push_back(elapsed(save, Clock::now()));
+    }
+    frametime.push_back(elapsed(begin, Clock::now()));
+  }
+  SNES::video.present_join();
+  double total = elapsed(start, Clock::now());
+  profiler.enable(false);
+  #if defined(DEBUGGER)
+  SNES::superfx.step_event.reset();
+  #endif
+  record.close();
+  if(frametime.size() == 0) return 0;
+
+  uint32_t statecrc = state_hash();
+
+  std::vector<double> sorted = frametime;
+  std::sort(sorted.begin(), sorted.end());
+  auto percentile = [&](double p) { return sorted[(unsigned)(p * (sorted.size() - 1))] * 1000.0; };
+
+  printf("profile:    %s\n", SNES::Info::Profile);
+  printf("cartridge:  %s (crc32 %.8x)\n", cartname, SNES::cartridge.crc32());
+  printf("frames:     %u in %.3fs (%.2f fps)\n", (unsigned)frametime.size(), total, frametime.size() / total);
+  printf("frame ms:   min %.3f  p50 %.3f  p90 %.3f  p99 %.3f  max %.3f\n",
+    percentile(0.0), percentile(0.5), percentile(0.9), percentile(0.99), percentile(1.0));
+  printf("state:      crc32 %.8x\n", statecrc);
+  printf("audio:      crc32 %.8x over %u samples\n", ~interface.audiocrc, interface.samples);
+  if(interface.tv != Interface::TV::None) printf("video:      crc32 %.8x over %u frames on a%s TV\n",
+    ~interface.videocrc, interface.pictures, interface.tv == Interface::TV::NTSC ? "n NTSC" : " PAL");
+  bool diverged = false;
+  if(SNES::cartridge.has_dsp1() && SNES::dsp1.mode == SNES::DSP1::Mode::Verify) {
+    diverged = SNES::dsp1.verify.diverged;
+    printf("dsp1:       verify, %u DR reads, %s\n", SNES::dsp1.verify.reads, diverged ? "diverged" : "no difference");
+  }
+  if(frameskip) printf("frameskip:  %u of %u frames skipped since power-on\n", interface.skipped, warmup + (unsigned)frametime.size());
+  if(savetime.size()) {
+    const SNES::System::SaveLatency &latency = SNES::system.save_latency;
+    std::sort(savetime.begin(), savetime.end());
+    printf("savestate:  %u saves, ms p50 %.3f  max %.3f; runtosave max %.3f ms, %u entries\n",
+      (unsigned)savetime.size(), savetime[savetime.size() / 2] * 1000.0, savetime.back() * 1000.0,
+      latency.max_time / 1000000.0, latency.max_entries);
+  }
+  printf("%-14s %10s %16s %12s\n", "processor", "frequency", "clocks", "clocks/frame");
+  for(unsigned i = 1; i < profiler.slots; i++) {
+    SNES::Processor *chip = profiler.processor[i];
+    uint64_t clocks = chip->cycles - cycles[i - 1];
+    //the S-DSP is clocked from the S-SMP oscillator
+    unsigned frequency = chip == &SNES::dsp ? SNES::smp.frequency : chip->frequency;
+    printf("%-14s %10u %16llu %12llu\n", (const char*)profiler.name(i), frequency,
+      (unsigned long long)clocks, (unsigned long long)(clocks / frametime.size()));
+  }
+  if(profile) print("\n", profiler.report());
+
+  if(roundtrips) {
+    SNES::system.runtosave();
+    unsigned size = SNES::system.serialize_size();
+    uint8_t *buffer = new uint8_t[size];
+
+    //serializer objects: one allocation and copy per save and per load
+    Clock::time_point begin = Clock::now();
+    for(unsigned n = 0; n < roundtrips; n++) {
+      serializer save = SNES::system.serialize();
+      memcpy(buffer, save.data(), save.size());
+      serializer load(buffer, size);
+      SNES::system.unserialize(load);
+    }
+    double copied = elapsed(begin, Clock::now());
+
+    //caller-owned buffer, as used by libsnes
+    begin = Clock::now();
+    for(unsigned n = 0; n < roundtrips; n++) {
+      SNES::system.serialize(buffer, size);
+      SNES::system.unserialize(buffer, size);
+    }
+    double inplace = elapsed(begin, Clock::now());
+    delete[] buffer;
+
+    printf("\nsavestate round trips (%u bytes):\n", size);
+    printf("  serializer  %10.0f/s\n", roundtrips / copied);
+    printf("  in-place    %10.0f/s\n", roundtrips / inplace);
+    printf("%-14s %10s %10s\n", "region", "offset", "size");
+    for(unsigned i = 0; i < SNES::system.state_regions; i++) {
+      const SNES::System::StateRegion &region = SNES::system.state_region[i];
+      printf("%-14s %10u %10u\n", region.name, region.offset, region.size);
+    }
+  }
+
+  bool deltafailed = false;
+  if(deltaframes) {
+    SNES::system.runtosave();
+    serializer keyframe = SNES::system.serialize();
+    unsigned since = SNES::system.epoch();
+    for(unsigned n = 0; n < deltaframes; n++) SNES::system.run();
+    SNES::system.runtosave();
+    serializer delta = SNES::system.serialize_delta(since);
+    serializer full = SNES::system.serialize();
+
+    //a state loaded from a savestate can differ from the running one in a few thread
+    //clocks, so the delta is compared with the full savestate as loaded
+    serializer base(full.data(), full.capacity());
+    SNES::system.unserialize(base);
+    uint32_t fullcrc = state_hash();
+
+    //hashing takes a savestate too, so the keyframe is loaded again before each delta
+    base = serializer(keyframe.data(), keyframe.capacity());
+    SNES::system.unserialize(base);
+    uint32_t keyframecrc = state_hash();
+
+    base = serializer(keyframe.data(), keyframe.capacity());
+    SNES::system.unserialize(base);
+    serializer load(delta.data(), delta.size());
+    bool applied = SNES::system.unserialize_delta(load);
+    uint32_t deltacrc = state_hash();
+
+    //the same delta again: the current state is no longer its base
+    load = serializer(delta.data(), delta.size());
+    bool stale = SNES::system.unserialize_delta(load);
+
+    //a truncated delta must be rejected before anything is loaded
+    base = serializer(keyframe.data(), keyframe.capacity());
+    SNES::system.unserialize(base);
+    load = serializer(delta.data(), delta.size() - 1);
+    bool truncated = SNES::system.unserialize_delta(load) || state_hash() != keyframecrc;
+
+    deltafailed = !applied || deltacrc != fullcrc || stale || truncated;
+    printf("\ndelta:      crc32 %.8x after %u frames, %u of %u bytes%s\n", deltacrc, deltaframes,
+      delta.size(), delta.capacity(), applied ? "" : " (rejected)");
+    printf("full:       crc32 %.8x\n", fullcrc);
+    printf("stale and truncated deltas: %s\n", !stale && !truncated ? "rejected" : "applied");
+  }
+
+  SNES::cartridge.unload();
+  SNES::system.term();
+  return diverged || deltafailed ? 1 : 0;
+}
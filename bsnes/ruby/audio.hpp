@@ -3,6 +3,9 @@ public:
   static const char *Volume;
   static const char *Resample;
   static const char *ResampleRatio;
+  static const char *OutputThread;
+  static const char *Underruns;
+  static const char *Overruns;
 
   static const char *Handle;
   static const char *Synchronize;
@@ -1,4 +1,7 @@
 #include <ruby/ruby.hpp>
+#include <nall/spscring.hpp>
+#include <chrono>
+#include <thread>
 using namespace nall;
 
 #undef mkdir
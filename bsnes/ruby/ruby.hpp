@@ -74,6 +74,13 @@ private:
   bool   resample_enabled;
   double r_step, r_frac;
   int    r_left[4], r_right[4];
+
+  //output thread: the driver is fed from its own thread through a lock-free ring
+  struct Output;
+  Output *output;
+  void output_sample(uint16_t left, uint16_t right);
+  void output_start();
+  void output_stop();
 };
 
 class InputInterface {
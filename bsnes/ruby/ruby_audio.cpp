@@ -1,18 +1,98 @@
 const char *Audio::Volume = "Volume";
 const char *Audio::Resample = "Resample";
 const char *Audio::ResampleRatio = "ResampleRatio";
+const char *Audio::OutputThread = "OutputThread";
+const char *Audio::Underruns = "Underruns";
+const char *Audio::Overruns = "Overruns";
 
 const char *Audio::Handle = "Handle";
 const char *Audio::Synchronize = "Synchronize";
 const char *Audio::Frequency = "Frequency";
 const char *Audio::Latency = "Latency";
 
+//with Audio::OutputThread, samples are collected into batches on the emulation thread
+//and pushed into a ring, which a thread of its own drains into the driver. drivers may
+//block until the device has room; that now happens on the output thread, and the
+//emulation thread only waits when the ring is full and the driver is synchronized.
+struct AudioInterface::Output {
+  enum : unsigned { BatchSize = 64, BlockSize = 256 };
+
+  bool enabled;
+  bool synchronize;  //wait for room in the ring rather than drop samples
+  spsc_ring<uint32_t> ring;
+  uint32_t batch[BatchSize];
+  unsigned batch_length;
+
+  std::thread thread;
+  std::atomic<bool> running;
+  std::atomic<unsigned> underruns;  //times the output thread ran out of samples
+  std::atomic<unsigned> overruns;   //samples dropped because the ring was full
+
+  Output() : enabled(false), synchronize(false), batch_length(0), running(false), underruns(0), overruns(0) {}
+};
+
+void AudioInterface::output_start() {
+  if(!output->enabled || !p || output->running) return;
+
+  output->synchronize = p->cap(Audio::Synchronize) && any_cast<bool>(p->get(Audio::Synchronize));
+  unsigned frequency = p->cap(Audio::Frequency) ? any_cast<unsigned>(p->get(Audio::Frequency)) : 48000;
+  unsigned latency = p->cap(Audio::Latency) ? any_cast<unsigned>(p->get(Audio::Latency)) : 80;
+  //half of the driver latency: enough to ride out scheduling jitter without adding much delay
+  unsigned capacity = max(512U, frequency * latency / 2000);
+  if(output->ring.capacity() != bit::round(capacity)) output->ring.resize(capacity);
+
+  output->running = true;
+  output->thread = std::thread([this] {
+    uint32_t block[Output::BlockSize];
+    bool drained = true;
+    while(output->running) {
+      unsigned length = output->ring.pop(block, Output::BlockSize);
+      if(length == 0) {
+        if(!drained) output->underruns++;
+        drained = true;
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        continue;
+      }
+      drained = false;
+      for(unsigned i = 0; i < length; i++) p->sample(block[i] >> 0, block[i] >> 16);
+    }
+  });
+}
+
+void AudioInterface::output_stop() {
+  if(!output->running) return;
+  output->running = false;
+  output->thread.join();
+}
+
+void AudioInterface::output_sample(uint16_t left, uint16_t right) {
+  if(!output->running) {
+    if(p) p->sample(left, right);
+    return;
+  }
+
+  output->batch[output->batch_length++] = left << 0 | (uint32_t)right << 16;
+  if(output->batch_length < Output::BatchSize) return;
+
+  unsigned pushed = output->ring.push(output->batch, output->batch_length);
+  while(pushed < output->batch_length && output->synchronize) {
+    std::this_thread::sleep_for(std::chrono::microseconds(500));
+    pushed += output->ring.push(output->batch + pushed, output->batch_length - pushed);
+  }
+  output->overruns += output->batch_length - pushed;
+  output->batch_length = 0;
+}
+
 bool AudioInterface::init() {
   if(!p) driver();
-  return p->init();
+  output_stop();
+  bool result = p->init();
+  output_start();
+  return result;
 }
 
 void AudioInterface::term() {
+  output_stop();
   if(p) {
     delete p;
     p = 0;
@@ -23,6 +103,9 @@ bool AudioInterface::cap(const string& name) {
   if(name == Audio::Volume) return true;
   if(name == Audio::Resample) return true;
   if(name == Audio::ResampleRatio) return true;
+  if(name == Audio::OutputThread) return true;
+  if(name == Audio::Underruns) return true;
+  if(name == Audio::Overruns) return true;
 
   return p ? p->cap(name) : false;
 }
@@ -31,6 +114,9 @@ any AudioInterface::get(const string& name) {
   if(name == Audio::Volume) return volume;
   if(name == Audio::Resample) return resample_enabled;
   if(name == Audio::ResampleRatio) return r_step;
+  if(name == Audio::OutputThread) return output->enabled;
+  if(name == Audio::Underruns) return (unsigned)output->underruns;
+  if(name == Audio::Overruns) return (unsigned)output->overruns;
 
   return p ? p->get(name) : false;
 }
@@ -52,7 +138,19 @@ bool AudioInterface::set(const string& name, const any& value) {
     return true;
   }
 
-  return p ? p->set(name, value) : false;
+  if(name == Audio::OutputThread) {
+    output_stop();
+    output->enabled = any_cast<bool>(value);
+    output_start();
+    return true;
+  }
+
+  //drivers are not thread-safe: keep the output thread out while they change
+  if(!p) return false;
+  output_stop();
+  bool result = p->set(name, value);
+  output_start();
+  return result;
 }
 
 //4-tap hermite interpolation
@@ -98,7 +196,7 @@ void AudioInterface::sample(uint16_t left, uint16_t right) {
   r_right[3] = s_right;
 
   if(resample_enabled == false) {
-    if(p) p->sample(left, right);
+    output_sample(left, right);
     return;
   }
 
@@ -106,7 +204,7 @@ void AudioInterface::sample(uint16_t left, uint16_t right) {
     int output_left  = sclamp<16>(hermite(r_frac, r_left [0], r_left [1], r_left [2], r_left [3]));
     int output_right = sclamp<16>(hermite(r_frac, r_right[0], r_right[1], r_right[2], r_right[3]));
     r_frac += r_step;
-    if(p) p->sample(output_left, output_right);
+    output_sample(output_left, output_right);
   }
 
   r_frac -= 1.0;
@@ -116,7 +214,12 @@ void AudioInterface::clear() {
   r_frac = 0;
   r_left [0] = r_left [1] = r_left [2] = r_left [3] = 0;
   r_right[0] = r_right[1] = r_right[2] = r_right[3] = 0;
+
+  output_stop();
+  output->ring.reset();
+  output->batch_length = 0;
   if(p) p->clear();
+  output_start();
 }
 
 AudioInterface::AudioInterface() {
@@ -126,8 +229,10 @@ AudioInterface::AudioInterface() {
   r_step = r_frac = 0;
   r_left [0] = r_left [1] = r_left [2] = r_left [3] = 0;
   r_right[0] = r_right[1] = r_right[2] = r_right[3] = 0;
+  output = new Output;
 }
 
 AudioInterface::~AudioInterface() {
   term();
+  delete output;
 }
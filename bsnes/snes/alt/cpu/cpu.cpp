@@ -23,6 +23,7 @@ namespace SNES {
 #include "timing.cpp"
 
 void CPU::step(unsigned clocks) {
+  cycles += clocks;
   smp.clock -= clocks * (uint64)smp.frequency;
   ppu.clock -= clocks;
   for(unsigned i = 0; i < coprocessors.size(); i++) {
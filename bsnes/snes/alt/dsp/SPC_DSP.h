@@ -234,6 +234,21 @@ private:
 
 public:
 	bool mute() { return m.regs[r_flg] & 0x40; }
+
+	// bsnes: APU RAM that echo writes may reach until the registers change
+	// (size bytes from the latched and current ESA, and 4 bytes at the echo pointer)
+	int echo_window( uint16_t base [2], uint16_t& pointer ) const
+	{
+		base [0] = m.t_esa * 0x100;
+		base [1] = m.regs [r_esa] * 0x100;
+		pointer = m.t_echo_ptr;
+		if ( m.t_echo_enabled & m.regs [r_flg] & 0x20 )
+			return 0;
+		int size = (m.regs [r_edl] & 0x0F) * 0x800;
+		if ( size < m.echo_length )
+			size = m.echo_length;
+		return size < 4 ? 4 : size;
+	}
 };
 
 #include <assert.h>
@@ -14,6 +14,7 @@ namespace SNES {
 #include "SPC_DSP.cpp"
 
 void DSP::step(unsigned clocks) {
+  cycles += clocks;
   clock += clocks;
 }
 
@@ -25,13 +26,21 @@ void DSP::synchronize_smp() {
   }
 }
 
+//runs every clock the S-DSP is behind the S-SMP by in one go (see SMP::synchronize_dsp)
 void DSP::enter() {
-  spc_dsp.run(1);
-  step(24);
+  unsigned clocks = clock < 0 ? (unsigned)(23 - clock) / 24 : 1;
+  spc_dsp.run(clocks);
+  step(clocks * 24);
 
   signed count = spc_dsp.sample_count();
   if(count > 0) {
     for(unsigned n = 0; n < count; n += 2) audio.sample(samplebuffer[n + 0], samplebuffer[n + 1]);
+    //the buffer is part of savestates: leave it as running one clock at a time would
+    if(count > 2) {
+      samplebuffer[0] = samplebuffer[count - 2];
+      samplebuffer[1] = samplebuffer[count - 1];
+      memset(samplebuffer + 2, 0, (count - 2) * sizeof(int16));
+    }
     spc_dsp.set_output(samplebuffer, 8192);
   }
 }
@@ -52,6 +61,10 @@ void DSP::load(uint8 const regs [SPC_DSP::register_count]) {
   spc_dsp.load(regs);
 }
 
+unsigned DSP::echo_window(uint16 base[2], uint16 &pointer) const {
+  return spc_dsp.echo_window(base, pointer);
+}
+
 void DSP::power() {
   spc_dsp.init(memory::apuram.data());
   spc_dsp.reset();
@@ -12,6 +12,7 @@ public:
   uint8 read(uint8 addr);
   void write(uint8 addr, uint8 data);
   void load(uint8 const regs [SPC_DSP::register_count]);
+  unsigned echo_window(uint16 base[2], uint16 &pointer) const;
 
   void enter();
   void power();
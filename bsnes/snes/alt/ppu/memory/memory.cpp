@@ -31,15 +31,16 @@ uint8 PPU::vram_mmio_read(uint16 addr) {
 
 void PPU::vram_mmio_write(uint16 addr, uint8 data) {
   if(regs.display_disabled == true) {
-    memory::vram[addr] = data;
+    memory::vram.assign(addr, data);
   } else {
     uint16 v = cpu.vcounter_past(6);
     if(v >= (!overscan() ? 225 : 240)) {
-      memory::vram[addr] = data;
+      memory::vram.assign(addr, data);
     } else if(v == 0 && cpu.hcounter_past(6) == 0) {
-      memory::vram[addr] = cpu.regs.mdr;
+      memory::vram.assign(addr, cpu.regs.mdr);
     }
   }
+  render_write(false, addr);
 }
 
 uint8 PPU::oam_mmio_read(uint16 addr) {
@@ -67,14 +68,14 @@ void PPU::oam_mmio_write(uint16 addr, uint8 data) {
   sprite_list_valid = false;
 
   if(regs.display_disabled == true) {
-    memory::oam[addr] = data;
+    memory::oam.write(addr, data);
     update_sprite_list(addr, data);
   } else {
     if(cpu.vcounter() < (!overscan() ? 225 : 240)) {
-      memory::oam[regs.ioamaddr] = data;
+      memory::oam.write(regs.ioamaddr, data);
       update_sprite_list(regs.ioamaddr, data);
     } else {
-      memory::oam[addr] = data;
+      memory::oam.write(addr, data);
       update_sprite_list(addr, data);
     }
   }
@@ -105,16 +106,17 @@ void PPU::cgram_mmio_write(uint16 addr, uint8 data) {
   if(addr & 1) data &= 0x7f;
 
   if(1 || regs.display_disabled == true) {
-    memory::cgram[addr] = data;
+    memory::cgram.write(addr, data);
   } else {
     uint16 v = cpu.vcounter();
     uint16 h = cpu.hcounter();
     if(v < (!overscan() ? 225 : 240) && h >= 128 && h < 1096) {
-      memory::cgram[regs.icgramaddr] = data & 0x7f;
+      memory::cgram.write(regs.icgramaddr, data & 0x7f);
     } else {
-      memory::cgram[addr] = data;
+      memory::cgram.write(addr, data);
     }
   }
+  render_write(true, addr);
 }
 
 #endif
@@ -196,9 +196,7 @@ void PPU::mmio_w2117(uint8 value) {
 void PPU::mmio_w2118(uint8 value) {
 uint16 addr = get_vram_address();
   vram_mmio_write(addr, value);
-  bg_tiledata_state[TILE_2BIT][(addr >> 4)] = 1;
-  bg_tiledata_state[TILE_4BIT][(addr >> 5)] = 1;
-  bg_tiledata_state[TILE_8BIT][(addr >> 6)] = 1;
+  invalidate_tiledata(addr);
 
   if(regs.vram_incmode == 0) {
     regs.vram_addr += regs.vram_incsize;
@@ -209,9 +207,7 @@ uint16 addr = get_vram_address();
 void PPU::mmio_w2119(uint8 value) {
 uint16 addr = get_vram_address() + 1;
   vram_mmio_write(addr, value);
-  bg_tiledata_state[TILE_2BIT][(addr >> 4)] = 1;
-  bg_tiledata_state[TILE_4BIT][(addr >> 5)] = 1;
-  bg_tiledata_state[TILE_8BIT][(addr >> 6)] = 1;
+  invalidate_tiledata(addr);
 
   if(regs.vram_incmode == 1) {
     regs.vram_addr += regs.vram_incsize;
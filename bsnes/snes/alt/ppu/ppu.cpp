@@ -1,5 +1,10 @@
 #include <snes.hpp>
 
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
 #include "wasm/drawlist_render.hpp"
 
 #define PPU_CPP
@@ -18,6 +23,7 @@ namespace SNES {
 #include "serialization.cpp"
 
 void PPU::step(unsigned clocks) {
+  cycles += clocks;
   clock += clocks;
 }
 
@@ -107,12 +113,17 @@ void PPU::scanline() {
 }
 
 void PPU::render_scanline() {
-  if(framecounter) return;
+  //sprite range and time over flags are visible to the S-CPU, so they are
+  //evaluated even when the line itself is not drawn
+  bool render = framecounter == 0 && system.render_video();
+  //ppux draw lists are bound to this instance, so they are drawn serially
+  bool queue = render_thread && ppux_modules.empty();
+  line_field = field();
   if(line >= 1 && line < (!overscan() ? 225 : 240)) {
     render_line_oam_rto();
-    render_line();
+    if(render) queue ? render_queue(false) : render_line();
   } else if(line >= 1 && line < 240) {
-    render_line_clear();
+    if(render) queue ? render_queue(true) : render_line_clear();
   }
 }
 
@@ -131,11 +142,16 @@ void PPU::power() {
   ppu1_version = config().ppu1.version;
   ppu2_version = config().ppu2.version;
 
-  for(unsigned i = 0; i < memory::vram.size();  i++) memory::vram[i]  = 0x00;
-  for(unsigned i = 0; i < memory::oam.size();   i++) memory::oam[i]   = 0x00;
-  for(unsigned i = 0; i < memory::cgram.size(); i++) memory::cgram[i] = 0x00;
+  for(unsigned i = 0; i < memory::vram.size();  i++) memory::vram.assign(i, 0x00);
+  for(unsigned i = 0; i < memory::oam.size();   i++) memory::oam.write(i, 0x00);
+  for(unsigned i = 0; i < memory::cgram.size(); i++) memory::cgram.write(i, 0x00);
   flush_tiledata_cache();
 
+  vram_data = &memory::vram[0];
+  cgram_data = memory::cgram.data();
+  set_render_thread(config().ppu2.render_thread);
+  render_invalidate();
+
   region = (system.region() == System::Region::NTSC ? 0 : 1);  //0 = NTSC, 1 = PAL
 
   regs.ioamaddr   = 0x0000;
@@ -349,6 +365,7 @@ void PPU::power() {
 void PPU::reset() {
   create(Enter, system.cpu_frequency());
   PPUcounter::reset();
+  render_join();
   memset(surface, 0, 512 * 512 * sizeof(uint16));
 
   frame();
@@ -401,6 +418,10 @@ PPU::PPU() {
   output = surface + 16 * 512;
 
   alloc_tiledata_cache();
+  render_thread = 0;
+  vram_data = 0;
+  cgram_data = 0;
+  line_field = false;
 
   for(unsigned l = 0; l < 16; l++) {
     for(unsigned i = 0; i < 4096; i++) {
@@ -439,6 +460,7 @@ PPU::PPU() {
 }
 
 PPU::~PPU() {
+  set_render_thread(false);
   delete[] surface;
   free_tiledata_cache();
 }
@@ -4,6 +4,7 @@ public:
   enum : bool { SupportsLayerEnable = true };
   enum : bool { SupportsFrameSkip = true };
   enum : bool { SupportsVRAMExpansion = false };
+  enum : bool { SupportsRenderThread = true };
 
   alwaysinline void step(unsigned clocks);
   alwaysinline void synchronize_cpu();
@@ -32,7 +32,7 @@ uint16 PPU::bg_get_tile(uint16 x, uint16 y) {
   if(x & 0x20) pos += bg_info[bg].scx;
 
   const uint16 addr = regs.bg_scaddr[bg] + (pos << 1);
-  return memory::vram[addr] + (memory::vram[addr + 1] << 8);
+  return vram_data[addr] + (vram_data[addr + 1] << 8);
 }
 
 #define setpixel_main(x) \
@@ -87,7 +87,7 @@ void PPU::render_line_bg(uint8 pri0_pos, uint8 pri1_pos) {
   uint16 vscroll = regs.bg_vofs[bg];
 
   if(hires && regs.interlace) {
-    y = (y << 1) | (field() && !regs.mosaic_enabled[bg]);
+    y = (y << 1) | (line_field && !regs.mosaic_enabled[bg]);
   }
 
   uint16 hval, vval;
@@ -171,7 +171,7 @@ void PPU::render_line_bg(uint8 pri0_pos, uint8 pri1_pos) {
       tile_num += tiledata_index;
       tile_num &= tile_mask;
 
-      if(bg_td_state[tile_num] == 1) {
+      if(bg_td_state[tile_num]) {
         render_bg_tile<color_depth>(tile_num);
       }
 
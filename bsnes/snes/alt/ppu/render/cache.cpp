@@ -1,105 +1,32 @@
 #ifdef PPU_CPP
 
-#define render_bg_tile_line_2bpp(mask) \
-  col  = !!(d0 & mask) << 0; \
-  col += !!(d1 & mask) << 1; \
-  *dest++ = col
-
-#define render_bg_tile_line_4bpp(mask) \
-  col  = !!(d0 & mask) << 0; \
-  col += !!(d1 & mask) << 1; \
-  col += !!(d2 & mask) << 2; \
-  col += !!(d3 & mask) << 3; \
-  *dest++ = col
-
-#define render_bg_tile_line_8bpp(mask) \
-  col  = !!(d0 & mask) << 0; \
-  col += !!(d1 & mask) << 1; \
-  col += !!(d2 & mask) << 2; \
-  col += !!(d3 & mask) << 3; \
-  col += !!(d4 & mask) << 4; \
-  col += !!(d5 & mask) << 5; \
-  col += !!(d6 & mask) << 6; \
-  col += !!(d7 & mask) << 7; \
-  *dest++ = col
-
+//decodes a whole row at a time: planar_table[d] spreads the bits of bitplane byte d
+//into the low bit of eight pixel bytes, so each bitplane costs one lookup, shift and
+//or. no bit crosses into the next byte, so this does not depend on host endianness.
 template<unsigned color_depth>
 void PPU::render_bg_tile(uint16 tile_num) {
-  uint8 col, d0, d1, d2, d3, d4, d5, d6, d7;
+  const unsigned planes = 2 << color_depth;
+  uint8 *dest = bg_tiledata[color_depth] + tile_num * 64;
+  const uint8 *src = &vram_data[tile_num * (8 * planes)];
+  uint8 &state = bg_tiledata_state[color_depth][tile_num];
 
-  if(color_depth == COLORDEPTH_4) {
-    uint8 *dest = (uint8*)bg_tiledata[TILE_2BIT] + tile_num * 64;
-    unsigned pos = tile_num * 16;
-    unsigned y = 8;
-    while(y--) {
-      d0 = memory::vram[pos    ];
-      d1 = memory::vram[pos + 1];
-      render_bg_tile_line_2bpp(0x80);
-      render_bg_tile_line_2bpp(0x40);
-      render_bg_tile_line_2bpp(0x20);
-      render_bg_tile_line_2bpp(0x10);
-      render_bg_tile_line_2bpp(0x08);
-      render_bg_tile_line_2bpp(0x04);
-      render_bg_tile_line_2bpp(0x02);
-      render_bg_tile_line_2bpp(0x01);
-      pos += 2;
+  //only the rows written to since the last decode are dirty
+  for(unsigned y = 0; y < 8; y++) {
+    if(!(state & (1 << y))) continue;
+    const uint8 *d = src + y * 2;
+    uint64 row = planar_table[d[0]] | planar_table[d[1]] << 1;
+    if(color_depth >= COLORDEPTH_16) {
+      row |= planar_table[d[16]] << 2 | planar_table[d[17]] << 3;
     }
-    bg_tiledata_state[TILE_2BIT][tile_num] = 0;
-  }
-
-  if(color_depth == COLORDEPTH_16) {
-    uint8 *dest = (uint8*)bg_tiledata[TILE_4BIT] + tile_num * 64;
-    unsigned pos = tile_num * 32;
-    unsigned y = 8;
-    while(y--) {
-      d0 = memory::vram[pos     ];
-      d1 = memory::vram[pos +  1];
-      d2 = memory::vram[pos + 16];
-      d3 = memory::vram[pos + 17];
-      render_bg_tile_line_4bpp(0x80);
-      render_bg_tile_line_4bpp(0x40);
-      render_bg_tile_line_4bpp(0x20);
-      render_bg_tile_line_4bpp(0x10);
-      render_bg_tile_line_4bpp(0x08);
-      render_bg_tile_line_4bpp(0x04);
-      render_bg_tile_line_4bpp(0x02);
-      render_bg_tile_line_4bpp(0x01);
-      pos += 2;
+    if(color_depth == COLORDEPTH_256) {
+      row |= planar_table[d[32]] << 4 | planar_table[d[33]] << 5;
+      row |= planar_table[d[48]] << 6 | planar_table[d[49]] << 7;
     }
-    bg_tiledata_state[TILE_4BIT][tile_num] = 0;
-  }
-
-  if(color_depth == COLORDEPTH_256) {
-    uint8 *dest = (uint8*)bg_tiledata[TILE_8BIT] + tile_num * 64;
-    unsigned pos = tile_num * 64;
-    unsigned y = 8;
-    while(y--) {
-      d0 = memory::vram[pos     ];
-      d1 = memory::vram[pos +  1];
-      d2 = memory::vram[pos + 16];
-      d3 = memory::vram[pos + 17];
-      d4 = memory::vram[pos + 32];
-      d5 = memory::vram[pos + 33];
-      d6 = memory::vram[pos + 48];
-      d7 = memory::vram[pos + 49];
-      render_bg_tile_line_8bpp(0x80);
-      render_bg_tile_line_8bpp(0x40);
-      render_bg_tile_line_8bpp(0x20);
-      render_bg_tile_line_8bpp(0x10);
-      render_bg_tile_line_8bpp(0x08);
-      render_bg_tile_line_8bpp(0x04);
-      render_bg_tile_line_8bpp(0x02);
-      render_bg_tile_line_8bpp(0x01);
-      pos += 2;
-    }
-    bg_tiledata_state[TILE_8BIT][tile_num] = 0;
+    memcpy(dest + y * 8, &row, 8);
   }
+  state = 0;
 }
 
-#undef render_bg_tile_line_2bpp
-#undef render_bg_tile_line_4bpp
-#undef render_bg_tile_line_8bpp
-
 void PPU::flush_pixel_cache() {
   uint16 main = get_palette(0);
   uint16 sub  = (regs.pseudo_hires || regs.bg_mode == 5 || regs.bg_mode == 6)
@@ -126,13 +53,27 @@ void PPU::alloc_tiledata_cache() {
   bg_tiledata_state[TILE_2BIT] = new uint8_t[  4096]();
   bg_tiledata_state[TILE_4BIT] = new uint8_t[  2048]();
   bg_tiledata_state[TILE_8BIT] = new uint8_t[  1024]();
+
+  for(unsigned d = 0; d < 256; d++) {
+    uint8 pixels[8];
+    for(unsigned x = 0; x < 8; x++) pixels[x] = (d >> (7 - x)) & 1;
+    memcpy(&planar_table[d], pixels, 8);
+  }
+}
+
+//marks the row of each tile format that holds addr as dirty
+void PPU::invalidate_tiledata(uint16 addr) {
+  uint8 row = 1 << ((addr >> 1) & 7);
+  bg_tiledata_state[TILE_2BIT][addr >> 4] |= row;
+  bg_tiledata_state[TILE_4BIT][addr >> 5] |= row;
+  bg_tiledata_state[TILE_8BIT][addr >> 6] |= row;
 }
 
 //marks all tiledata cache entries as dirty
 void PPU::flush_tiledata_cache() {
-  for(unsigned i = 0; i < 4096; i++) bg_tiledata_state[TILE_2BIT][i] = 1;
-  for(unsigned i = 0; i < 2048; i++) bg_tiledata_state[TILE_4BIT][i] = 1;
-  for(unsigned i = 0; i < 1024; i++) bg_tiledata_state[TILE_8BIT][i] = 1;
+  memset(bg_tiledata_state[TILE_2BIT], 0xff, 4096);
+  memset(bg_tiledata_state[TILE_4BIT], 0xff, 2048);
+  memset(bg_tiledata_state[TILE_8BIT], 0xff, 1024);
 }
 
 void PPU::free_tiledata_cache() {
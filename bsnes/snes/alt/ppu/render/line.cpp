@@ -2,7 +2,7 @@
 
 inline uint16 PPU::get_palette(uint8 index) {
   const unsigned addr = index << 1;
-  return memory::cgram[addr] + (memory::cgram[addr + 1] << 8);
+  return cgram_data[addr] + (cgram_data[addr + 1] << 8);
 }
 
 //p = 00000bgr <palette data>
@@ -85,7 +85,7 @@ inline uint16 PPU::get_pixel_swap(uint32 x) {
 }
 
 inline void PPU::render_line_output() {
-  uint16 *ptr = (uint16*)output + (line * 1024) + ((interlace() && field()) ? 512 : 0);
+  uint16 *ptr = (uint16*)output + (line * 1024) + ((interlace() && line_field) ? 512 : 0);
   uint16 *luma = light_table[regs.display_brightness];
 
   if(!regs.pseudo_hires && regs.bg_mode != 5 && regs.bg_mode != 6) {
@@ -101,7 +101,7 @@ inline void PPU::render_line_output() {
 }
 
 inline void PPU::render_line_clear() {
-  uint16 *ptr = (uint16*)output + (line * 1024) + ((interlace() && field()) ? 512 : 0);
+  uint16 *ptr = (uint16*)output + (line * 1024) + ((interlace() && line_field) ? 512 : 0);
   uint16 width = (!regs.pseudo_hires && regs.bg_mode != 5 && regs.bg_mode != 6) ? 256 : 512;
   memset(ptr, 0, width * 2 * sizeof(uint16));
 }
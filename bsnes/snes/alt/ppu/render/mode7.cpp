@@ -64,7 +64,7 @@ void PPU::render_line_mode7(uint8 pri0_pos, uint8 pri1_pos) {
         py &= 1023;
         tx = ((px >> 3) & 127);
         ty = ((py >> 3) & 127);
-        tile    = memory::vram[(ty * 128 + tx) << 1];
+        tile    = vram_data[(ty * 128 + tx) << 1];
         ppux_mode7_fetch(px, py, tile, bg, palette, ppuxcolor);
       } break;
       case 2: {  //palette color 0 outside of screen area
@@ -75,7 +75,7 @@ void PPU::render_line_mode7(uint8 pri0_pos, uint8 pri1_pos) {
           py &= 1023;
           tx = ((px >> 3) & 127);
           ty = ((py >> 3) & 127);
-          tile    = memory::vram[(ty * 128 + tx) << 1];
+          tile    = vram_data[(ty * 128 + tx) << 1];
           ppux_mode7_fetch(px, py, tile, bg, palette, ppuxcolor);
         }
       } break;
@@ -87,7 +87,7 @@ void PPU::render_line_mode7(uint8 pri0_pos, uint8 pri1_pos) {
           py &= 1023;
           tx = ((px >> 3) & 127);
           ty = ((py >> 3) & 127);
-          tile = memory::vram[(ty * 128 + tx) << 1];
+          tile = vram_data[(ty * 128 + tx) << 1];
         }
         ppux_mode7_fetch(px, py, tile, bg, palette, ppuxcolor);
       } break;
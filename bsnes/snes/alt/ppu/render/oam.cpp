@@ -135,7 +135,7 @@ void PPU::render_oam_tile(int tile_num) {
   uint8 *oam_td       = (uint8*)bg_tiledata[COLORDEPTH_16];
   uint8 *oam_td_state = (uint8*)bg_tiledata_state[COLORDEPTH_16];
 
-  if(oam_td_state[t->tile] == 1) {
+  if(oam_td_state[t->tile]) {
     render_bg_tile<COLORDEPTH_16>(t->tile);
   }
 
@@ -92,7 +92,7 @@ void PPU::ppux_mode7_fetch(int32 px, int32 py, int32 tile, unsigned layer, int32
     return;
   }
 
-  palette = memory::vram[(((tile << 6) + ((py & 7) << 3) + (px & 7)) << 1) + 1];
+  palette = vram_data[(((tile << 6) + ((py & 7) << 3) + (px & 7)) << 1) + 1];
 }
 
 void PPU::ppux_render_line_pre() {
@@ -8,6 +8,7 @@
 #include "addsub.cpp"
 #include "line.cpp"
 #include "ppux.cpp"
+#include "thread.cpp"
 
 //Mode 0: ->
 //     1,    2,    3,    4,    5,    6,    7,    8,    9,   10,   11,   12
@@ -26,12 +26,14 @@ struct pixel_t {
 } pixel_cache[256];
 
 uint8 *bg_tiledata[3];
-uint8 *bg_tiledata_state[3];  //0 = valid, 1 = dirty
+uint8 *bg_tiledata_state[3];  //one bit per row: 0 = valid, 1 = dirty
+uint64 planar_table[256];     //bitplane byte -> one bit in each of eight pixel bytes
 
 template<unsigned color_depth> void render_bg_tile(uint16 tile_num);
 inline void flush_pixel_cache();
 void alloc_tiledata_cache();
 void flush_tiledata_cache();
+alwaysinline void invalidate_tiledata(uint16 addr);
 void free_tiledata_cache();
 
 //windows.cpp
@@ -97,3 +99,16 @@ inline uint16 get_pixel_normal(uint32 x);
 inline uint16 get_pixel_swap(uint32 x);
 void   render_line_output();
 void   render_line_clear();
+
+//thread.cpp
+struct RenderThread;
+RenderThread *render_thread;
+uint8 *vram_data, *cgram_data;  //memory the line renderer reads from
+bool line_field;                //field() of the line being rendered
+
+void set_render_thread(bool enable);
+bool get_render_thread() const { return render_thread; }
+void render_join();
+void render_invalidate();
+inline void render_write(bool cgram, uint16 addr);
+void render_queue(bool clear);
@@ -0,0 +1,200 @@
+#ifdef PPU_CPP
+
+//optional render thread: rather than drawing each line as it is reached, the
+//S-PPU queues a snapshot of the registers that affect the line and a second
+//PPU instance draws it on another thread while emulation continues.
+//
+//the renderer reads VRAM and CGRAM from its own shadow copies. every VRAM and
+//CGRAM write made by the S-CPU is logged, and the log is replayed into the
+//shadows up to the position recorded with each line, so that every line sees
+//memory exactly as it was when the serial renderer would have drawn it.
+//Video::update() joins the thread before the frame is presented.
+//
+//lines are drawn in order by a single worker: the write log forces ordering,
+//and one worker is enough to take rendering off the emulation thread.
+
+struct PPU::RenderThread {
+  enum : unsigned { LineCount = 256, WriteCount = 65536 };
+
+  struct Line {
+    decltype(PPU::regs) regs;
+    decltype(PPU::cache) cache;
+    decltype(PPU::display) display;
+    oam_tileitem oam_tilelist[34];
+    bool layer_enabled[5][4];
+    unsigned line;
+    bool field;
+    bool clear;
+    unsigned writes;  //write log position this line is drawn at
+  };
+
+  struct Write {
+    uint16 addr;
+    uint8 data;
+    bool cgram;
+  };
+
+  PPU renderer;
+  uint8 vram[65536];
+  uint8 cgram[512];
+  bool stale;  //shadows must be reloaded from memory before the next line
+
+  Line lines[LineCount];
+  Write writes[WriteCount];
+  std::atomic<unsigned> line_head, line_tail;
+  std::atomic<unsigned> write_head, write_tail;
+
+  std::mutex mutex;
+  std::condition_variable wake, idle;
+  bool stop;
+  std::thread thread;
+
+  //replays logged writes into the shadows, up to (but not including) position
+  void apply(unsigned position) {
+    unsigned n = write_tail.load(std::memory_order_relaxed);
+    for(; n != position; n++) {
+      const Write &w = writes[n % WriteCount];
+      if(w.cgram) {
+        cgram[w.addr] = w.data;
+      } else {
+        vram[w.addr] = w.data;
+        renderer.invalidate_tiledata(w.addr);
+      }
+    }
+    write_tail.store(n, std::memory_order_release);
+  }
+
+  void render(const Line &job) {
+    apply(job.writes);
+
+    renderer.regs = job.regs;
+    renderer.cache = job.cache;
+    renderer.display = job.display;
+    memcpy(renderer.oam_tilelist, job.oam_tilelist, sizeof renderer.oam_tilelist);
+    memcpy(renderer.layer_enabled, job.layer_enabled, sizeof renderer.layer_enabled);
+    renderer.line = job.line;
+    renderer.line_field = job.field;
+
+    if(job.clear) {
+      renderer.render_line_clear();
+    } else {
+      memset(renderer.oam_line_pri, OAM_PRI_NONE, 256);
+      renderer.render_line();
+    }
+  }
+
+  void run() {
+    while(true) {
+      unsigned tail = line_tail.load(std::memory_order_relaxed);
+      if(tail == line_head.load(std::memory_order_acquire)) {
+        std::unique_lock<std::mutex> lock(mutex);
+        idle.notify_all();
+        wake.wait(lock, [&] { return stop || tail != line_head.load(std::memory_order_acquire); });
+        if(stop) return;
+      }
+
+      render(lines[tail % LineCount]);
+      line_tail.store(tail + 1, std::memory_order_release);
+    }
+  }
+
+  bool busy() const {
+    return line_tail.load(std::memory_order_acquire) != line_head.load(std::memory_order_relaxed);
+  }
+
+  void join() {
+    if(!busy()) return;
+    std::unique_lock<std::mutex> lock(mutex);
+    idle.wait(lock, [&] { return !busy(); });
+  }
+
+  RenderThread(PPU &self) : line_head(0), line_tail(0), write_head(0), write_tail(0) {
+    renderer.output = self.output;
+    renderer.vram_data = vram;
+    renderer.cgram_data = cgram;
+    renderer.ppux_render_frame_pre();
+    stale = true;
+    stop = false;
+    thread = std::thread([this] { run(); });
+  }
+
+  ~RenderThread() {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      stop = true;
+    }
+    wake.notify_all();
+    thread.join();
+  }
+};
+
+void PPU::set_render_thread(bool enable) {
+  if(enable == (bool)render_thread) return;
+  if(enable) {
+    render_thread = new RenderThread(*this);
+  } else {
+    delete render_thread;
+    render_thread = 0;
+  }
+}
+
+void PPU::render_join() {
+  if(render_thread) render_thread->join();
+}
+
+//memory was changed without going through the S-PPU (power, state load, debugger)
+void PPU::render_invalidate() {
+  if(render_thread) render_thread->stale = true;
+}
+
+void PPU::render_write(bool cgram, uint16 addr) {
+  if(!render_thread) return;
+  RenderThread &t = *render_thread;
+
+  unsigned head = t.write_head.load(std::memory_order_relaxed);
+  if(head - t.write_tail.load(std::memory_order_acquire) == RenderThread::WriteCount) {
+    //log is full: once the queued lines are drawn, the rest can be applied here
+    t.join();
+    t.apply(head);
+  }
+
+  RenderThread::Write &w = t.writes[head % RenderThread::WriteCount];
+  w.addr = addr;
+  w.data = cgram ? memory::cgram[addr] : memory::vram[addr];
+  w.cgram = cgram;
+  t.write_head.store(head + 1, std::memory_order_release);
+}
+
+void PPU::render_queue(bool clear) {
+  RenderThread &t = *render_thread;
+
+  if(t.stale) {
+    t.join();
+    memcpy(t.vram, &memory::vram[0], sizeof t.vram);
+    memcpy(t.cgram, memory::cgram.data(), sizeof t.cgram);
+    t.renderer.flush_tiledata_cache();
+    t.write_tail.store(t.write_head.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    t.stale = false;
+  }
+
+  unsigned head = t.line_head.load(std::memory_order_relaxed);
+  if(head - t.line_tail.load(std::memory_order_acquire) == RenderThread::LineCount) t.join();
+
+  RenderThread::Line &job = t.lines[head % RenderThread::LineCount];
+  job.regs = regs;
+  job.cache = cache;
+  job.display = display;
+  memcpy(job.oam_tilelist, oam_tilelist, sizeof job.oam_tilelist);
+  memcpy(job.layer_enabled, layer_enabled, sizeof job.layer_enabled);
+  job.line = line;
+  job.field = line_field;
+  job.clear = clear;
+  job.writes = t.write_head.load(std::memory_order_relaxed);
+  t.line_head.store(head + 1, std::memory_order_release);
+
+  //taking the lock orders this against a worker that is about to wait
+  { std::lock_guard<std::mutex> lock(t.mutex); }
+  t.wake.notify_one();
+}
+
+#endif
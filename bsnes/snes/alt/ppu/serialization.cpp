@@ -3,6 +3,7 @@
 #include <ppu/counter/serialization.cpp>
 
 void PPU::serialize(serializer &s) {
+  if(s.mode() == serializer::Load) render_invalidate();
   Processor::serialize(s);
   PPUcounter::serialize(s);
 
@@ -132,6 +133,17 @@ void PPU::serialize(serializer &s) {
   s.integer(regs.oam_itemcount);
   s.integer(regs.oam_tilecount);
 
+  //the line buffers below are rebuilt by every render_line() before use. they are
+  //saved cleared, so that states do not depend on whether lines were drawn
+  //(frameskip, System::render_video)
+  if(s.mode() == serializer::Save) {
+    memset(pixel_cache, 0, sizeof pixel_cache);
+    memset(window, 0, sizeof window);
+    memset(bg_info, 0, sizeof bg_info);
+    memset(oam_line_pal, 0, sizeof oam_line_pal);
+    memset(oam_line_pri, 0, sizeof oam_line_pri);
+  }
+
   for(unsigned n = 0; n < 256; n++) {
     s.integer(pixel_cache[n].src_main);
     s.integer(pixel_cache[n].src_sub);
@@ -48,6 +48,7 @@ void Cartridge::load(Mode cartridge_mode, const lstring &xml_list) {
   has_superfx    = false;
   has_sa1        = false;
   has_necdsp     = false;
+  has_dsp1       = false;
   has_srtc       = false;
   has_sdd1       = false;
   has_spc7110    = false;
@@ -47,6 +47,7 @@ public:
   readonly<bool> has_superfx;
   readonly<bool> has_sa1;
   readonly<bool> has_necdsp;
+  readonly<bool> has_dsp1;
   readonly<bool> has_srtc;
   readonly<bool> has_sdd1;
   readonly<bool> has_spc7110;
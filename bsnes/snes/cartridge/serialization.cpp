@@ -2,31 +2,38 @@
 
 void Cartridge::serialize(serializer &s) {
   if(memory::cartram.size() != 0) {
-    s.array(memory::cartram.data(), memory::cartram.size());
+    memory::cartram.serialize(s);
   }
 
   if(memory::cartrtc.size() != 0) {
-    s.array(memory::cartrtc.data(), memory::cartrtc.size());
+    memory::cartrtc.serialize(s);
   }
 
   if(memory::bsxpram.size() != 0) {
-    s.array(memory::bsxpram.data(), memory::bsxpram.size());
+    memory::bsxpram.serialize(s);
   }
 
   if(memory::stAram.size() != 0) {
-    s.array(memory::stAram.data(), memory::stAram.size());
+    memory::stAram.serialize(s);
   }
 
   if(memory::stBram.size() != 0) {
-    s.array(memory::stBram.data(), memory::stBram.size());
+    memory::stBram.serialize(s);
+  }
+
+  //the Super Game Boy library writes these through raw pointers, so their
+  //pages cannot be tracked: always store them in full
+  if(DirtyPages::delta && s.mode() == serializer::Save) {
+    memory::gbram.mark_all();
+    memory::gbrtc.mark_all();
   }
 
   if(memory::gbram.size() != 0) {
-    s.array(memory::gbram.data(), memory::gbram.size());
+    memory::gbram.serialize(s);
   }
 
   if(memory::gbrtc.size() != 0) {
-    s.array(memory::gbrtc.data(), memory::gbrtc.size());
+    memory::gbrtc.serialize(s);
   }
 }
 
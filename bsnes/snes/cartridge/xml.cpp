@@ -209,6 +209,7 @@ void Cartridge::xml_parse_necdsp(xml_element &root) {
 
   string program, programhash;
   string sha256;
+  string emulation = "lle";
 
   foreach(attr, root.attribute) {
     if(attr.name == "revision") {
@@ -219,11 +220,23 @@ void Cartridge::xml_parse_necdsp(xml_element &root) {
     } else if(attr.name == "program") {
       program << filepath(dir(basename()), config().path.firmware);
       program << attr.content;
+      if(attr.content.beginswith("dsp1")) emulation = config().coprocessor.dsp1;
     } else if(attr.name == "sha256") {
       sha256 = attr.content;
     }
   }
 
+  //the DSP-1 command set can be emulated without running its program
+  foreach(attr, root.attribute) {
+    if(attr.name == "emulation") emulation = attr.content;
+  }
+  if(necdsp.revision != NECDSP::Revision::uPD7725) emulation = "lle";
+  if(emulation == "hle" || emulation == "verify") {
+    has_dsp1 = true;
+    has_necdsp = (emulation == "verify");
+    dsp1.mode = (emulation == "hle" ? DSP1::Mode::HLE : DSP1::Mode::Verify);
+  }
+
   unsigned promsize = (necdsp.revision == NECDSP::Revision::uPD7725 ? 2048 : 16384);
   unsigned dromsize = (necdsp.revision == NECDSP::Revision::uPD7725 ? 1024 :  2048);
   unsigned filesize = promsize * 3 + dromsize * 2;
@@ -272,7 +285,7 @@ void Cartridge::xml_parse_necdsp(xml_element &root) {
     }
 
     if(node.name == "map") {
-      Mapping m(necdsp);
+      Mapping m(has_dsp1 ? (Memory&)dsp1 : (Memory&)necdsp);
       foreach(attr, node.attribute) {
         if(attr.name == "address") xml_parse_address(m, attr.content);
       }
@@ -280,6 +293,12 @@ void Cartridge::xml_parse_necdsp(xml_element &root) {
     }
   }
 
+  if(has_dsp1) {
+    for(unsigned n = 0; n < 1024; n++) dsp1.dataROM[n] = necdsp.dataROM[n];
+    dsp1.drmask = necdsp.drmask, dsp1.drtest = necdsp.drtest;
+    dsp1.srmask = necdsp.srmask, dsp1.srtest = necdsp.srtest;
+  }
+
   if(programhash == "") {
     system.interface->message({ "Warning: NEC DSP program ", program, " is missing." });
   } else if(sha256 != "" && sha256 != programhash) {
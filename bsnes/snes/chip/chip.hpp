@@ -7,6 +7,7 @@ struct Coprocessor : Processor {
 #include <chip/superfx/superfx.hpp>
 #include <chip/sa1/sa1.hpp>
 #include <chip/necdsp/necdsp.hpp>
+#include <chip/dsp1/dsp1.hpp>
 #include <chip/bsx/bsx.hpp>
 #include <chip/srtc/srtc.hpp>
 #include <chip/sdd1/sdd1.hpp>
@@ -18,6 +19,7 @@ struct Coprocessor : Processor {
 #include <chip/serial/serial.hpp>
 
 void Coprocessor::step(unsigned clocks) {
+  cycles += clocks;
   clock += clocks * (uint64)cpu.frequency;
 }
 
@@ -48,7 +48,10 @@ void Cx4::enter() {
       add_clocks(1);
     }
     
-    regs.irqPending |= wasBusy && !busy();
+    if (wasBusy && !busy()) {
+      synchronize_cpu();
+      regs.irqPending = true;
+    }
     if (regs.irqPending && !mmio.irqDisable) {
       cpu.regs.irq = 1;
     }
@@ -59,7 +62,7 @@ void Cx4::add_clocks(unsigned clocks) {
 
   while (clocks--) {
     step(1);
-    synchronize_cpu();
+    if (clock >= sync_window || regs.halt || bus_access()) synchronize_cpu();
 
     if(regs.rwbustime && --regs.rwbustime) {
       if (regs.writebus) {
@@ -89,6 +92,7 @@ void Cx4::nextpc() {
       regs.pc = regs.p << 8; // ?
       regs.cachePage = 1;
     } else {
+      synchronize_cpu();
       regs.halt = true;
     }
   }
@@ -107,6 +111,7 @@ void Cx4::change_page() {
   }
   // if both pages are locked (and invalid), halt
   else if (cache[regs.cachePage].lock) {
+    synchronize_cpu();
     regs.halt = true;
   }
 }
@@ -140,6 +145,7 @@ void Cx4::power() {
 
 void Cx4::reset() {
   create(Cx4::Enter, frequency);
+  sync_window = config().coprocessor.sync_window * (int64)system.cpu_frequency();
   
   memset(dataRAM, 0, sizeof(dataRAM));
   
@@ -6,6 +6,13 @@ public:
   
   static void Enter();
   void enter();
+
+  //batched synchronization (config().coprocessor.sync_window): while running code
+  //without using the bus, the Cx4 may run up to that many clocks ahead of the
+  //S-CPU. bus accesses, suspend, halting and the idle Cx4 stay in lock-step, so the
+  //busy flag and IRQ change when they did before; only the GPR window (regs.mdr
+  //while running) and S-CPU writes to the control registers may be that far off.
+  int64 sync_window;
   
   //memory.cpp
   uint8 read(unsigned addr);
@@ -429,11 +429,13 @@ void Cx4::instruction() {
   else if((opcode & 0xfc00) == 0xfc00) {
     //1111 11.. .... ....
     //halt
+    synchronize_cpu();
     regs.halt = true;
   }
 
   else {
     // unknown opcode
+    synchronize_cpu();
     regs.halt = true;
   }
 
@@ -7,6 +7,7 @@ uint8 Cx4::op_read(unsigned addr) {
     return dataRAM[addr & 0xfff];
   } else if ((addr & 0xf08000) == 0x700000) { // cart RAM
     add_clocks(mmio.ramSpeed);
+    synchronize_cpu();
     return cx4bus.read(addr);
   } else if ((addr & 0x408000) == 0x008000) { // cart ROM
     add_clocks(mmio.romSpeed);
@@ -21,6 +22,7 @@ void Cx4::op_write(unsigned addr, uint8 data) {
     dataRAM[addr & 0xfff] = data;
   } else if ((addr & 0xf08000) == 0x700000) { // cart RAM
     add_clocks(mmio.ramSpeed);
+    synchronize_cpu();
     cx4bus.write(addr, data);
   } else if ((addr & 0x408000) == 0x008000) { // cart ROM
     add_clocks(mmio.romSpeed);
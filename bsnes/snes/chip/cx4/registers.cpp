@@ -15,6 +15,7 @@ uint24 Cx4::register_read(uint8 addr) {
   case 0x20: data = regs.pc & 0xff; // already incremented to next instruction before access
   case 0x28: data = regs.p; break;
   case 0x2e: case 0x2f:
+    synchronize_cpu();  //the S-CPU loses the bus from here
     regs.rwbusaddr = regs.busaddr;
     regs.rwbustime = ((addr & 1) ? mmio.ramSpeed : mmio.romSpeed) + 1; //includes current cycle
     regs.writebus = false;
@@ -68,6 +69,7 @@ void Cx4::register_write(uint8 addr, uint24 data) {
   case 0x13: regs.busaddr = data; return;
   case 0x1c: regs.ramaddr = data; return;
   case 0x2e: case 0x2f:     
+    synchronize_cpu();  //the S-CPU loses the bus from here
     regs.rwbusaddr = regs.busaddr;
     regs.rwbustime = ((addr & 1) ? mmio.ramSpeed : mmio.romSpeed) + 1; //includes current cycle
     regs.writebus = true;
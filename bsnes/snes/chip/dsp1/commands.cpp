@@ -0,0 +1,419 @@
+#ifdef DSP1_CPP
+
+//parameter and result word counts of each command. commands $40-$ff are
+//ignored; $1a, $2a and $3a hang the DSP-1 until it is reset.
+const DSP1::Command DSP1::commands[64] = {
+  { &DSP1::multiply,    2,    1 }, { &DSP1::attitudeA,   4,    0 },  //$00
+  { &DSP1::parameter,   7,    4 }, { &DSP1::subjectiveA, 3,    3 },
+  { &DSP1::triangle,    2,    2 }, { &DSP1::attitudeA,   4,    0 },
+  { &DSP1::project,     3,    3 }, { &DSP1::memory_test, 1,    1 },
+  { &DSP1::radius,      3,    2 }, { &DSP1::objectiveA,  3,    3 },
+  { &DSP1::raster,      1,    4 }, { &DSP1::scalarA,     3,    1 },
+  { &DSP1::rotate,      3,    2 }, { &DSP1::objectiveA,  3,    3 },
+  { &DSP1::target,      2,    2 }, { &DSP1::memory_test, 1,    1 },
+
+  { &DSP1::inverse,     2,    2 }, { &DSP1::attitudeB,   4,    0 },  //$10
+  { &DSP1::parameter,   7,    4 }, { &DSP1::subjectiveB, 3,    3 },
+  { &DSP1::gyrate,      6,    3 }, { &DSP1::attitudeB,   4,    0 },
+  { &DSP1::project,     3,    3 }, { &DSP1::memory_dump, 1, 1024 },
+  { &DSP1::range,       4,    1 }, { &DSP1::objectiveB,  3,    3 },
+  { 0,                  0,    0 }, { &DSP1::scalarB,     3,    1 },
+  { &DSP1::polar,       6,    3 }, { &DSP1::objectiveB,  3,    3 },
+  { &DSP1::target,      2,    2 }, { &DSP1::memory_dump, 1, 1024 },
+
+  { &DSP1::multiply2,   2,    1 }, { &DSP1::attitudeC,   4,    0 },  //$20
+  { &DSP1::parameter,   7,    4 }, { &DSP1::subjectiveC, 3,    3 },
+  { &DSP1::triangle,    2,    2 }, { &DSP1::attitudeC,   4,    0 },
+  { &DSP1::project,     3,    3 }, { &DSP1::memory_size, 1,    1 },
+  { &DSP1::distance,    3,    1 }, { &DSP1::objectiveC,  3,    3 },
+  { 0,                  0,    0 }, { &DSP1::scalarC,     3,    1 },
+  { &DSP1::rotate,      3,    2 }, { &DSP1::objectiveC,  3,    3 },
+  { &DSP1::target,      2,    2 }, { &DSP1::memory_size, 1,    1 },
+
+  { &DSP1::inverse,     2,    2 }, { &DSP1::attitudeA,   4,    0 },  //$30
+  { &DSP1::parameter,   7,    4 }, { &DSP1::subjectiveA, 3,    3 },
+  { &DSP1::gyrate,      6,    3 }, { &DSP1::attitudeA,   4,    0 },
+  { &DSP1::project,     3,    3 }, { &DSP1::memory_dump, 1, 1024 },
+  { &DSP1::range2,      4,    1 }, { &DSP1::objectiveA,  3,    3 },
+  { 0,                  0,    0 }, { &DSP1::scalarA,     3,    1 },
+  { &DSP1::polar,       6,    3 }, { &DSP1::objectiveA,  3,    3 },
+  { &DSP1::target,      2,    2 }, { &DSP1::memory_dump, 1, 1024 },
+};
+
+//zenith angle limits for command $02, indexed by the exponent of the centre height
+const int16 DSP1::maxAZS[16] = {
+  0x38b4, 0x38b7, 0x38ba, 0x38be, 0x38c0, 0x38c4, 0x38c7, 0x38ca,
+  0x38ce, 0x38d0, 0x38d4, 0x38d7, 0x38da, 0x38dd, 0x38e0, 0x38e4,
+};
+
+void DSP1::memory_test(int16 *input, int16 *output) {
+  output[0] = 0x0000;
+}
+
+void DSP1::memory_dump(int16 *input, int16 *output) {
+  for(unsigned n = 0; n < 1024; n++) output[n] = dataROM[n];
+}
+
+void DSP1::memory_size(int16 *input, int16 *output) {
+  output[0] = 0x0100;
+}
+
+void DSP1::multiply(int16 *input, int16 *output) {
+  output[0] = input[0] * input[1] >> 15;
+}
+
+void DSP1::multiply2(int16 *input, int16 *output) {
+  output[0] = (input[0] * input[1] >> 15) + 1;
+}
+
+void DSP1::inverse(int16 *input, int16 *output) {
+  inverse(input[0], input[1], output[0], output[1]);
+}
+
+void DSP1::triangle(int16 *input, int16 *output) {
+  int16 angle = input[0], radius = input[1];
+  output[0] = sin(angle) * radius >> 15;
+  output[1] = cos(angle) * radius >> 15;
+}
+
+void DSP1::radius(int16 *input, int16 *output) {
+  int16 x = input[0], y = input[1], z = input[2];
+  int32 radius = (uint32)(x * x) + (uint32)(y * y) + (uint32)(z * z) << 1;
+  output[0] = radius >>  0;
+  output[1] = radius >> 16;
+}
+
+void DSP1::range(int16 *input, int16 *output) {
+  int16 x = input[0], y = input[1], z = input[2], r = input[3];
+  output[0] = (int32)((uint32)(x * x) + (uint32)(y * y) + (uint32)(z * z) - (uint32)(r * r)) >> 15;
+}
+
+void DSP1::range2(int16 *input, int16 *output) {
+  int16 x = input[0], y = input[1], z = input[2], r = input[3];
+  output[0] = ((int32)((uint32)(x * x) + (uint32)(y * y) + (uint32)(z * z) - (uint32)(r * r)) >> 15) + 1;
+}
+
+void DSP1::distance(int16 *input, int16 *output) {
+  int16 x = input[0], y = input[1], z = input[2];
+  int32 radius = (uint32)(x * x) + (uint32)(y * y) + (uint32)(z * z);
+  if(radius == 0) {
+    output[0] = 0;
+    return;
+  }
+
+  int16 c, e;
+  normalize_double(radius, c, e);
+  if(e & 1) c = c * 0x4000 >> 15;
+
+  int16 pos = c * 0x0040 >> 15;
+  int16 node1 = dataROM[0x00d5 + pos];
+  int16 node2 = dataROM[0x00d6 + pos];
+  output[0] = (((node2 - node1) * (c & 0x1ff) >> 9) + node1) >> (e >> 1);
+}
+
+void DSP1::rotate(int16 *input, int16 *output) {
+  int16 a = input[0], x1 = input[1], y1 = input[2];
+  output[0] = (y1 * sin(a) >> 15) + (x1 * cos(a) >> 15);
+  output[1] = (y1 * cos(a) >> 15) - (x1 * sin(a) >> 15);
+}
+
+void DSP1::polar(int16 *input, int16 *output) {
+  int16 za = input[0], xa = input[1], ya = input[2];
+  int16 x = input[3], y = input[4], z = input[5];
+  int16 x1, y1, z1;
+
+  //around Z
+  x1 = (y * sin(za) >> 15) + (x * cos(za) >> 15);
+  y1 = (y * cos(za) >> 15) - (x * sin(za) >> 15);
+  x = x1; y = y1;
+
+  //around X
+  y1 = (z * sin(xa) >> 15) + (y * cos(xa) >> 15);
+  z1 = (z * cos(xa) >> 15) - (y * sin(xa) >> 15);
+  y = y1; z = z1;
+
+  //around Y
+  z1 = (x * sin(ya) >> 15) + (z * cos(ya) >> 15);
+  x1 = (x * cos(ya) >> 15) - (z * sin(ya) >> 15);
+  z = z1; x = x1;
+
+  output[0] = x;
+  output[1] = y;
+  output[2] = z;
+}
+
+//matrices A, B and C are set by the attitude commands and used by the
+//objective, subjective and scalar commands with the same suffix
+
+void DSP1::attitude(int16 (&matrix)[3][3], int16 *input) {
+  int16 s = input[0] >> 1;
+  int16 sinAz = sin(input[1]), cosAz = cos(input[1]);
+  int16 sinAy = sin(input[2]), cosAy = cos(input[2]);
+  int16 sinAx = sin(input[3]), cosAx = cos(input[3]);
+
+  matrix[0][0] = (s * cosAz >> 15) * cosAy >> 15;
+  matrix[0][1] = -((s * sinAz >> 15) * cosAy >> 15);
+  matrix[0][2] = s * sinAy >> 15;
+
+  matrix[1][0] = ((s * sinAz >> 15) * cosAx >> 15) + (((s * cosAz >> 15) * sinAx >> 15) * sinAy >> 15);
+  matrix[1][1] = ((s * cosAz >> 15) * cosAx >> 15) - (((s * sinAz >> 15) * sinAx >> 15) * sinAy >> 15);
+  matrix[1][2] = -((s * sinAx >> 15) * cosAy >> 15);
+
+  matrix[2][0] = ((s * sinAz >> 15) * sinAx >> 15) - (((s * cosAz >> 15) * cosAx >> 15) * sinAy >> 15);
+  matrix[2][1] = ((s * cosAz >> 15) * sinAx >> 15) + (((s * sinAz >> 15) * cosAx >> 15) * sinAy >> 15);
+  matrix[2][2] = (s * cosAx >> 15) * cosAy >> 15;
+}
+
+void DSP1::attitudeA(int16 *input, int16 *output) { attitude(shared.matrixA, input); }
+void DSP1::attitudeB(int16 *input, int16 *output) { attitude(shared.matrixB, input); }
+void DSP1::attitudeC(int16 *input, int16 *output) { attitude(shared.matrixC, input); }
+
+void DSP1::objective(int16 (&matrix)[3][3], int16 *input, int16 *output) {
+  int16 x = input[0], y = input[1], z = input[2];
+  output[0] = (matrix[0][0] * x >> 15) + (matrix[1][0] * y >> 15) + (matrix[2][0] * z >> 15);
+  output[1] = (matrix[0][1] * x >> 15) + (matrix[1][1] * y >> 15) + (matrix[2][1] * z >> 15);
+  output[2] = (matrix[0][2] * x >> 15) + (matrix[1][2] * y >> 15) + (matrix[2][2] * z >> 15);
+}
+
+void DSP1::objectiveA(int16 *input, int16 *output) { objective(shared.matrixA, input, output); }
+void DSP1::objectiveB(int16 *input, int16 *output) { objective(shared.matrixB, input, output); }
+void DSP1::objectiveC(int16 *input, int16 *output) { objective(shared.matrixC, input, output); }
+
+void DSP1::subjective(int16 (&matrix)[3][3], int16 *input, int16 *output) {
+  int16 f = input[0], l = input[1], u = input[2];
+  output[0] = (matrix[0][0] * f >> 15) + (matrix[0][1] * l >> 15) + (matrix[0][2] * u >> 15);
+  output[1] = (matrix[1][0] * f >> 15) + (matrix[1][1] * l >> 15) + (matrix[1][2] * u >> 15);
+  output[2] = (matrix[2][0] * f >> 15) + (matrix[2][1] * l >> 15) + (matrix[2][2] * u >> 15);
+}
+
+void DSP1::subjectiveA(int16 *input, int16 *output) { subjective(shared.matrixA, input, output); }
+void DSP1::subjectiveB(int16 *input, int16 *output) { subjective(shared.matrixB, input, output); }
+void DSP1::subjectiveC(int16 *input, int16 *output) { subjective(shared.matrixC, input, output); }
+
+void DSP1::scalar(int16 (&matrix)[3][3], int16 *input, int16 *output) {
+  int16 x = input[0], y = input[1], z = input[2];
+  output[0] = (x * matrix[0][0] + y * matrix[1][0] + z * matrix[2][0]) >> 15;
+}
+
+void DSP1::scalarA(int16 *input, int16 *output) { scalar(shared.matrixA, input, output); }
+void DSP1::scalarB(int16 *input, int16 *output) { scalar(shared.matrixB, input, output); }
+void DSP1::scalarC(int16 *input, int16 *output) { scalar(shared.matrixC, input, output); }
+
+void DSP1::gyrate(int16 *input, int16 *output) {
+  int16 az = input[0], ax = input[1], ay = input[2];
+  int16 u = input[3], f = input[4], l = input[5];
+  int16 cSec, eSec, cSin, c, e;
+  int16 sinAy = sin(ay), cosAy = cos(ay);
+
+  inverse(cos(ax), 0, cSec, eSec);
+
+  //around Z
+  normalize_double(u * cosAy - f * sinAy, c, e);
+  e = eSec - e;
+  normalize(c * cSec >> 15, c, e);
+  output[0] = az + denormalize_and_clip(c, e);
+
+  //around X
+  output[1] = ax + (u * sinAy >> 15) + (f * cosAy >> 15);
+
+  //around Y
+  normalize_double(u * cosAy + f * sinAy, c, e);
+  e = eSec - e;
+  normalize(sin(ax), cSin, e);
+  normalize(-(c * (cSec * cSin >> 15) >> 15), c, e);
+  output[2] = ay + denormalize_and_clip(c, e) + l;
+}
+
+void DSP1::parameter(int16 *input, int16 *output) {
+  int16 fx = input[0], fy = input[1], fz = input[2];
+  int16 lfe = input[3], les = input[4], aas = input[5], azs = input[6];
+  int16 cSec, c, e;
+
+  //zenith angle, clipped below
+  int16 AZS = azs;
+
+  shared.sinAas = sin(aas);
+  shared.cosAas = cos(aas);
+  shared.sinAzs = sin(azs);
+  shared.cosAzs = cos(azs);
+
+  shared.nx = shared.sinAzs * -shared.sinAas >> 15;
+  shared.ny = shared.sinAzs * shared.cosAas >> 15;
+  shared.nz = shared.cosAzs * 0x7fff >> 15;
+
+  //centre of projection
+  shared.centreX = fx + (lfe * shared.nx >> 15);
+  shared.centreY = fy + (lfe * shared.ny >> 15);
+  shared.centreZ = fz + (lfe * shared.nz >> 15);
+
+  shared.gx = shared.centreX - (les * shared.nx >> 15);
+  shared.gy = shared.centreY - (les * shared.ny >> 15);
+  shared.gz = shared.centreZ - (les * shared.nz >> 15);
+
+  shared.les = les;
+  shared.eLes = 0;
+  normalize(les, shared.cLes, shared.eLes);
+
+  e = 0;
+  normalize(shared.centreZ, c, e);
+  shared.vPlaneC = c;
+  shared.vPlaneE = e;
+
+  int16 limit = maxAZS[-e & 15];
+  if(AZS < 0) {
+    limit = -limit;
+    if(AZS < limit + 1) AZS = limit + 1;
+  } else {
+    if(AZS > limit) AZS = limit;
+  }
+
+  shared.sinAZS = sin(AZS);
+  shared.cosAZS = cos(AZS);
+
+  inverse(shared.cosAZS, 0, shared.secAZSC1, shared.secAZSE1);
+  normalize(c * shared.secAZSC1 >> 15, c, e);
+  e += shared.secAZSE1;
+
+  c = denormalize_and_clip(c, e) * shared.sinAZS >> 15;
+
+  shared.centreX += c * shared.sinAas >> 15;
+  shared.centreY -= c * shared.cosAas >> 15;
+
+  output[2] = shared.centreX;
+  output[3] = shared.centreY;
+
+  //raster number of the imaginary centre and the horizon
+  int16 vof = 0;
+
+  if(azs != AZS || azs == limit) {
+    //outside the clipping interval, the program corrects with a Taylor series
+    if(azs == -32768) azs = -32767;
+
+    c = azs - limit;
+    if(c >= 0) c--;
+    int16 aux = ~(c << 2);
+
+    c = aux * (int16)dataROM[0x0328] >> 15;
+    c = (c * aux >> 15) + (int16)dataROM[0x0327];
+    vof -= (c * aux >> 15) * les >> 15;
+
+    c = aux * aux >> 15;
+    aux = (c * (int16)dataROM[0x0324] >> 15) + (int16)dataROM[0x0325];
+    shared.cosAZS += (c * aux >> 15) * shared.cosAZS >> 15;
+  }
+
+  shared.vOffset = les * shared.cosAZS >> 15;
+
+  inverse(shared.sinAZS, 0, cSec, e);
+  normalize(shared.vOffset, c, e);
+  normalize(c * cSec >> 15, c, e);
+
+  if(c == -32768) { c >>= 1; e++; }
+
+  output[0] = vof;
+  output[1] = denormalize_and_clip(-c, e);
+
+  inverse(shared.cosAZS, 0, shared.secAZSC2, shared.secAZSE2);
+}
+
+void DSP1::raster(int16 *input, int16 *output) {
+  int16 vs = input[0];
+  int16 c, e, c1, e1;
+
+  inverse((vs * shared.sinAzs >> 15) + shared.vOffset, 7, c, e);
+  e += shared.vPlaneE;
+
+  c1 = c * shared.vPlaneC >> 15;
+  e1 = e + shared.secAZSE2;
+
+  normalize(c1, c, e);
+  c = denormalize_and_clip(c, e);
+
+  output[0] = c * shared.cosAas >> 15;
+  output[2] = c * shared.sinAas >> 15;
+
+  normalize(c1 * shared.secAZSC2 >> 15, c, e1);
+  c = denormalize_and_clip(c, e1);
+
+  output[1] = c * -shared.sinAas >> 15;
+  output[3] = c * shared.cosAas >> 15;
+}
+
+void DSP1::target(int16 *input, int16 *output) {
+  int16 h = input[0], v = input[1];
+  int16 c, e, c1, e1;
+
+  inverse((v * shared.sinAzs >> 15) + shared.vOffset, 8, c, e);
+  e += shared.vPlaneE;
+
+  c1 = c * shared.vPlaneC >> 15;
+  e1 = e + shared.secAZSE1;
+
+  h <<= 8;
+  normalize(c1, c, e);
+  c = denormalize_and_clip(c, e) * h >> 15;
+
+  int16 x = shared.centreX + (c * shared.cosAas >> 15);
+  int16 y = shared.centreY - (c * shared.sinAas >> 15);
+
+  v <<= 8;
+  normalize(c1 * shared.secAZSC1 >> 15, c, e1);
+  c = denormalize_and_clip(c, e1) * v >> 15;
+
+  output[0] = x + (c * -shared.sinAas >> 15);
+  output[1] = y + (c * shared.cosAas >> 15);
+}
+
+void DSP1::project(int16 *input, int16 *output) {
+  int16 e = 0, e2 = 0, e3 = 0, e4 = 0, e6 = 0, e7 = 0, refE;
+  int16 px, py, pz;
+  int16 c2, c4, c6, c10, c19, c25;
+
+  normalize_double(int32(input[0]) - shared.gx, px, e4);
+  normalize_double(int32(input[1]) - shared.gy, py, e);
+  normalize_double(int32(input[2]) - shared.gz, pz, e3);
+
+  //halved so that the scalar products below cannot overflow
+  px >>= 1; e4--;
+  py >>= 1; e--;
+  pz >>= 1; e3--;
+
+  refE = min(min(e, e3), e4);
+  px = shift_right(px, e4 - refE);
+  py = shift_right(py, e  - refE);
+  pz = shift_right(pz, e3 - refE);
+
+  //distance of P from the screen plane along its normal
+  int16 dot = -(px * shared.nx >> 15) - (py * shared.ny >> 15) - (pz * shared.nz >> 15);
+  int32 aux4 = dot;
+  refE = 16 - refE;
+  if(refE >= 0) aux4 <<= refE;
+  else aux4 >>= -refE;
+  if(aux4 == -1) aux4 = 0;
+  aux4 >>= 1;
+
+  int32 aux = (uint16)shared.les + aux4;
+  normalize_double(aux, c10, e2);
+  e2 = 15 - e2;
+
+  inverse(c10, 0, c4, e4);
+  c2 = c4 * shared.cLes >> 15;  //scale factor
+
+  //H: P along the horizontal axis of the screen, scaled
+  int16 c17 = (px * (shared.cosAas * 0x7fff >> 15) >> 15) + (py * (shared.sinAas * 0x7fff >> 15) >> 15);
+  normalize(c17 * c2 >> 15, c19, e7);
+  output[0] = denormalize_and_clip(c19, shared.eLes - e2 + refE + e7);
+
+  //V: P along the vertical axis of the screen, scaled
+  int16 c24 = (px * (shared.cosAZS * -shared.sinAas >> 15) >> 15)
+            + (py * (shared.cosAZS * shared.cosAas >> 15) >> 15)
+            + (pz * (-shared.sinAZS * 0x7fff >> 15) >> 15);
+  normalize(c24 * c2 >> 15, c25, e6);
+  output[1] = denormalize_and_clip(c25, shared.eLes - e2 + refE + e6);
+
+  //M: the scale factor over 2^7
+  normalize(c2, c6, e4);
+  output[2] = denormalize_and_clip(c6, e4 + shared.eLes - e2 - 7);
+}
+
+#endif
@@ -0,0 +1,172 @@
+#include <snes.hpp>
+
+#define DSP1_CPP
+namespace SNES {
+
+DSP1 dsp1;
+
+#include "math.cpp"
+#include "commands.cpp"
+#include "serialization.cpp"
+
+void DSP1::init() {
+  //quarter-turn of sine in 1.15 fixed point, and n*pi for the interpolation step
+  const double pi = 3.14159265358979323846;
+  for(unsigned n = 0; n < 128; n++) {
+    int value = (int)floor(32768.0 * std::sin(n * pi / 128.0));
+    sinTable[n +   0] = min(value, 32767);
+    sinTable[n + 128] = -sinTable[n];
+  }
+  for(unsigned n = 0; n < 256; n++) mulTable[n] = (int16)floor(n * pi);
+}
+
+void DSP1::enable() {
+}
+
+void DSP1::power() {
+  reset();
+}
+
+void DSP1::reset() {
+  sr = RQM | DRC;
+  dr = 0x0080;
+  state = WaitCommand;
+  command = 0x00;
+  counter = 0;
+  memset(input, 0, sizeof input);
+  memset(output, 0, sizeof output);
+  memset(&shared, 0, sizeof shared);
+  verify.diverged = false;
+  verify.reads = 0;
+}
+
+uint8 DSP1::read(unsigned addr) {
+  if(mode == Mode::Verify) {
+    if(debugger_access()) return necdsp.read(addr);
+    cpu.synchronize_coprocessor();
+    bool ready = necdsp.regs.sr.rqm;
+    uint8 data = necdsp.read(addr);
+    if((addr & srmask) != srtest && (addr & drmask) == drtest && ready) verify_read(data, dr_read());
+    return data;
+  }
+
+  if((addr & srmask) == srtest) return sr;
+  if((addr & drmask) == drtest) return debugger_access() ? (uint8)dr : dr_read();
+  return 0x00;
+}
+
+void DSP1::write(unsigned addr, uint8 data) {
+  if(mode == Mode::Verify) {
+    if(!debugger_access()) cpu.synchronize_coprocessor();
+    bool ready = necdsp.regs.sr.rqm;
+    necdsp.write(addr, data);
+    if((addr & srmask) != srtest && (addr & drmask) == drtest && ready) dr_write(data);
+    return;
+  }
+
+  if((addr & srmask) == srtest) return;
+  if((addr & drmask) == drtest) return dr_write(data);
+}
+
+//DR is accessed a byte at a time; a 16-bit transfer completes on its high byte.
+//the DSP-1 only leaves RQM clear once it has hung on an undefined command.
+uint8 DSP1::dr_read() {
+  if(!(sr & RQM)) return dr;
+  uint8 data;
+  if(!(sr & DRC)) {
+    if(!(sr & DRS)) {
+      sr |= DRS;
+      return dr >> 0;
+    }
+    sr &= ~DRS;
+    data = dr >> 8;
+  } else {
+    data = dr >> 0;
+  }
+  dr_step();
+  return data;
+}
+
+void DSP1::dr_write(uint8 data) {
+  if(!(sr & RQM)) return;
+  if(!(sr & DRC)) {
+    if(!(sr & DRS)) {
+      sr |= DRS;
+      dr = (dr & 0xff00) | (data << 0);
+      return;
+    }
+    sr &= ~DRS;
+    dr = (data << 8) | (dr & 0x00ff);
+  } else {
+    dr = (dr & 0xff00) | (data << 0);
+  }
+  dr_step();
+}
+
+void DSP1::dr_step() {
+  switch(state) {
+  case WaitCommand:
+    command = dr;
+    if(command & 0xc0) break;
+    if(commands[command].execute == 0) {
+      sr &= ~RQM;
+      break;
+    }
+    counter = 0;
+    state = ReadData;
+    sr &= ~DRC;
+    break;
+
+  case ReadData:
+    input[counter++] = dr;
+    if(counter < commands[command].reads) break;
+    (this->*commands[command].execute)(input, output);
+    counter = 0;
+    if(commands[command].writes) {
+      dr = output[0];
+      state = WriteData;
+    } else {
+      dr = 0x0080;
+      sr |= DRC;
+      state = WaitCommand;
+    }
+    break;
+
+  case WriteData:
+    if(++counter < commands[command].writes) {
+      dr = output[counter];
+      break;
+    }
+    if(command == 0x0a && dr != 0x8000) {
+      //raster data is produced line after line until the S-CPU writes $8000
+      input[0]++;
+      raster(input, output);
+      counter = 0;
+      dr = output[0];
+      break;
+    }
+    dr = 0x0080;
+    sr |= DRC;
+    state = WaitCommand;
+    break;
+  }
+}
+
+void DSP1::verify_read(uint8 expected, uint8 actual) {
+  verify.reads++;
+  if(verify.diverged || expected == actual) return;
+  verify.diverged = true;
+  system.interface->message({
+    "DSP-1 HLE diverged from the NEC DSP at DR read ", verify.reads,
+    " (command $", hex<2>(command), "): NEC DSP $", hex<2>(expected), ", HLE $", hex<2>(actual)
+  });
+}
+
+DSP1::DSP1() {
+  mode = Mode::HLE;
+}
+
+DSP1::~DSP1() {
+}
+
+}
@@ -0,0 +1,123 @@
+//high-level emulation of the DSP-1 command set, in place of running the
+//DSP-1 program on the NEC uPD7725 core. it answers every command as soon as
+//its last parameter is written, so there is no coprocessor thread to schedule.
+//the tables the program reads (normalization shifts, reciprocal and square
+//root seeds, Taylor coefficients) come from the data ROM in the firmware file.
+//
+//in Verify mode the NEC DSP still drives the bus; every DR access is mirrored
+//here, and the first data byte that differs between the two is reported.
+
+class DSP1 : public Memory {
+public:
+  enum class Mode : unsigned { HLE, Verify } mode;
+  unsigned drmask, drtest;
+  unsigned srmask, srtest;
+  uint16 dataROM[1024];
+
+  //Verify mode: DR reads compared so far, and whether one has differed
+  struct Verify {
+    bool diverged;
+    unsigned reads;
+  } verify;
+
+  void init();
+  void enable();
+  void power();
+  void reset();
+
+  uint8 read(unsigned addr);
+  void write(unsigned addr, uint8 data);
+
+  void serialize(serializer&);
+  DSP1();
+  ~DSP1();
+
+private:
+  enum : unsigned { RQM = 0x80, DRS = 0x10, DRC = 0x04 };
+  enum : unsigned { WaitCommand, ReadData, WriteData };
+
+  struct Command {
+    void (DSP1::*execute)(int16 *input, int16 *output);
+    unsigned reads;
+    unsigned writes;
+  };
+  static const Command commands[64];
+  static const int16 maxAZS[16];
+  int16 sinTable[256];
+  int16 mulTable[256];
+
+  uint8 sr;
+  uint16 dr;
+  unsigned state;
+  uint8 command;
+  unsigned counter;
+  int16 input[7];
+  int16 output[1024];
+
+  struct Shared {
+    int16 matrixA[3][3], matrixB[3][3], matrixC[3][3];
+    int16 centreX, centreY, centreZ;
+    int16 vOffset;
+    int16 vPlaneC, vPlaneE;
+    int16 les, cLes, eLes;
+    int16 sinAas, cosAas;
+    int16 sinAzs, cosAzs;
+    int16 sinAZS, cosAZS;
+    int16 secAZSC1, secAZSE1;
+    int16 secAZSC2, secAZSE2;
+    int16 nx, ny, nz;
+    int16 gx, gy, gz;
+  } shared;
+
+  uint8 dr_read();
+  void dr_write(uint8 data);
+  void dr_step();
+  void verify_read(uint8 expected, uint8 actual);
+
+  //math.cpp
+  int16 sin(int16 angle);
+  int16 cos(int16 angle);
+  void inverse(int16 coefficient, int16 exponent, int16 &iCoefficient, int16 &iExponent);
+  void normalize(int16 m, int16 &coefficient, int16 &exponent);
+  void normalize_double(int32 product, int16 &coefficient, int16 &exponent);
+  int16 denormalize_and_clip(int16 c, int16 e);
+  int16 shift_right(int16 c, int16 e);
+
+  //commands.cpp
+  void memory_test(int16 *input, int16 *output);
+  void memory_dump(int16 *input, int16 *output);
+  void memory_size(int16 *input, int16 *output);
+  void multiply(int16 *input, int16 *output);
+  void multiply2(int16 *input, int16 *output);
+  void inverse(int16 *input, int16 *output);
+  void triangle(int16 *input, int16 *output);
+  void radius(int16 *input, int16 *output);
+  void range(int16 *input, int16 *output);
+  void range2(int16 *input, int16 *output);
+  void distance(int16 *input, int16 *output);
+  void rotate(int16 *input, int16 *output);
+  void polar(int16 *input, int16 *output);
+  void attitude(int16 (&matrix)[3][3], int16 *input);
+  void attitudeA(int16 *input, int16 *output);
+  void attitudeB(int16 *input, int16 *output);
+  void attitudeC(int16 *input, int16 *output);
+  void objective(int16 (&matrix)[3][3], int16 *input, int16 *output);
+  void objectiveA(int16 *input, int16 *output);
+  void objectiveB(int16 *input, int16 *output);
+  void objectiveC(int16 *input, int16 *output);
+  void subjective(int16 (&matrix)[3][3], int16 *input, int16 *output);
+  void subjectiveA(int16 *input, int16 *output);
+  void subjectiveB(int16 *input, int16 *output);
+  void subjectiveC(int16 *input, int16 *output);
+  void scalar(int16 (&matrix)[3][3], int16 *input, int16 *output);
+  void scalarA(int16 *input, int16 *output);
+  void scalarB(int16 *input, int16 *output);
+  void scalarC(int16 *input, int16 *output);
+  void gyrate(int16 *input, int16 *output);
+  void parameter(int16 *input, int16 *output);
+  void raster(int16 *input, int16 *output);
+  void target(int16 *input, int16 *output);
+  void project(int16 *input, int16 *output);
+};
+
+extern DSP1 dsp1;
@@ -0,0 +1,136 @@
+#ifdef DSP1_CPP
+
+//fixed-point primitives of the DSP-1 program. dataROM[0x22-0x40] holds the
+//powers of two used to shift by multiplication, dataROM[0x65-0xe4] the
+//reciprocal seeds and dataROM[0xe5-0x115] the square root table.
+
+int16 DSP1::sin(int16 angle) {
+  if(angle < 0) {
+    if(angle == -32768) return 0;
+    return -sin(-angle);
+  }
+  int32 s = sinTable[angle >> 8] + (mulTable[angle & 0xff] * sinTable[0x40 + (angle >> 8)] >> 15);
+  if(s > 32767) s = 32767;
+  return s;
+}
+
+int16 DSP1::cos(int16 angle) {
+  if(angle < 0) {
+    if(angle == -32768) return -32768;
+    angle = -angle;
+  }
+  int32 s = sinTable[0x40 + (angle >> 8)] - (mulTable[angle & 0xff] * sinTable[angle >> 8] >> 15);
+  if(s < -32768) s = -32767;
+  return s;
+}
+
+void DSP1::inverse(int16 coefficient, int16 exponent, int16 &iCoefficient, int16 &iExponent) {
+  //division by zero
+  if(coefficient == 0x0000) {
+    iCoefficient = 0x7fff;
+    iExponent = 0x002f;
+    return;
+  }
+
+  int16 sign = 1;
+  if(coefficient < 0) {
+    if(coefficient < -32767) coefficient = -32767;
+    coefficient = -coefficient;
+    sign = -1;
+  }
+
+  while(coefficient < 0x4000) {
+    coefficient <<= 1;
+    exponent--;
+  }
+
+  if(coefficient == 0x4000) {
+    if(sign == 1) {
+      iCoefficient = 0x7fff;
+    } else {
+      iCoefficient = -0x4000;
+      exponent--;
+    }
+  } else {
+    //table seed, refined by two Newton-Raphson steps
+    int16 i = dataROM[((coefficient - 0x4000) >> 7) + 0x0065];
+    i = (i + (-i * (coefficient * i >> 15) >> 15)) << 1;
+    i = (i + (-i * (coefficient * i >> 15) >> 15)) << 1;
+    iCoefficient = i * sign;
+  }
+
+  iExponent = 1 - exponent;
+}
+
+void DSP1::normalize(int16 m, int16 &coefficient, int16 &exponent) {
+  int16 i = 0x4000;
+  int16 e = 0;
+
+  if(m < 0) {
+    while((m & i) && i) { i >>= 1; e++; }
+  } else {
+    while(!(m & i) && i) { i >>= 1; e++; }
+  }
+
+  if(e > 0) {
+    coefficient = m * dataROM[0x0021 + e] << 1;
+  } else {
+    coefficient = m;
+  }
+  exponent -= e;
+}
+
+void DSP1::normalize_double(int32 product, int16 &coefficient, int16 &exponent) {
+  int16 n = product & 0x7fff;
+  int16 m = product >> 15;
+  int16 i = 0x4000;
+  int16 e = 0;
+
+  if(m < 0) {
+    while((m & i) && i) { i >>= 1; e++; }
+  } else {
+    while(!(m & i) && i) { i >>= 1; e++; }
+  }
+
+  if(e > 0) {
+    coefficient = m * dataROM[0x0021 + e] << 1;
+
+    if(e < 15) {
+      coefficient += n * dataROM[0x0040 - e] >> 15;
+    } else {
+      i = 0x4000;
+
+      if(m < 0) {
+        while((n & i) && i) { i >>= 1; e++; }
+      } else {
+        while(!(n & i) && i) { i >>= 1; e++; }
+      }
+
+      if(e > 15) {
+        coefficient = n * dataROM[0x0012 + e] << 1;
+      } else {
+        coefficient += n;
+      }
+    }
+  } else {
+    coefficient = m;
+  }
+
+  exponent = e;
+}
+
+int16 DSP1::denormalize_and_clip(int16 c, int16 e) {
+  if(e > 0) {
+    if(c > 0) return 32767;
+    if(c < 0) return -32767;
+  } else if(e < 0) {
+    return c * dataROM[0x0031 + e] >> 15;
+  }
+  return c;
+}
+
+int16 DSP1::shift_right(int16 c, int16 e) {
+  return c * dataROM[0x0031 + e] >> 15;
+}
+
+#endif
@@ -0,0 +1,46 @@
+#ifdef DSP1_CPP
+
+void DSP1::serialize(serializer &s) {
+  s.integer(sr);
+  s.integer(dr);
+
+  s.integer(state);
+
+  s.integer(command);
+  s.integer(counter);
+  s.array(input);
+  s.array(output);
+
+  for(unsigned n = 0; n < 3; n++) {
+    s.array(shared.matrixA[n]);
+    s.array(shared.matrixB[n]);
+    s.array(shared.matrixC[n]);
+  }
+  s.integer(shared.centreX);
+  s.integer(shared.centreY);
+  s.integer(shared.centreZ);
+  s.integer(shared.vOffset);
+  s.integer(shared.vPlaneC);
+  s.integer(shared.vPlaneE);
+  s.integer(shared.les);
+  s.integer(shared.cLes);
+  s.integer(shared.eLes);
+  s.integer(shared.sinAas);
+  s.integer(shared.cosAas);
+  s.integer(shared.sinAzs);
+  s.integer(shared.cosAzs);
+  s.integer(shared.sinAZS);
+  s.integer(shared.cosAZS);
+  s.integer(shared.secAZSC1);
+  s.integer(shared.secAZSE1);
+  s.integer(shared.secAZSC2);
+  s.integer(shared.secAZSE2);
+  s.integer(shared.nx);
+  s.integer(shared.ny);
+  s.integer(shared.nz);
+  s.integer(shared.gx);
+  s.integer(shared.gy);
+  s.integer(shared.gz);
+}
+
+#endif
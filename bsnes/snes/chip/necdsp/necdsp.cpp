@@ -27,10 +27,32 @@ void NECDSP::enter() {
     regs.n = result <<  1;  //store low 15-bits + zero
 
     step(1);
-    synchronize_cpu();
+    if(clock >= sync_window || (clock >= 0 && shared(programROM[regs.pc]))) synchronize_cpu();
   }
 }
 
+//true if the instruction accesses state that the S-CPU can also access
+bool NECDSP::shared(uint24 opcode) const {
+  if(opcode >> 22 == 2) {  //JP
+    uint9 brch = opcode >> 13;
+    return brch == 0x0bc || brch == 0x0be;  //JNRQM, JRQM
+  }
+
+  uint4 dst = opcode >> 0;
+  if(dst == 6 || dst == 7) return true;  //DR, SR
+  if(datamapped && (dst == 12 || dst == 15)) return true;
+  if(opcode >> 22 == 3) return false;  //LD
+
+  uint4 src = opcode >> 4;
+  if(src == 8 || src == 9 || src == 10) return true;  //DR, SR
+  if(datamapped) {
+    uint2 pselect = opcode >> 20;
+    uint4 alu     = opcode >> 16;
+    if(src == 15 || (alu && pselect == 0)) return true;
+  }
+  return false;
+}
+
 void NECDSP::exec_op(uint24 opcode) {
   uint2 pselect = opcode >> 20;  //P select
   uint4 alu     = opcode >> 16;  //ALU operation mode
@@ -264,6 +286,8 @@ void NECDSP::power() {
 
 void NECDSP::reset() {
   create(NECDSP::Enter, frequency);
+  sync_window = config().coprocessor.sync_window * (int64)system.cpu_frequency();
+  datamapped = (dptest & ~dpmask & 0xffffff) == 0;
 
   for(unsigned n = 0; n < 16; n++) regs.stack[n] = 0x0000;
   regs.pc = 0x0000;
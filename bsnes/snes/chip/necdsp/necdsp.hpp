@@ -19,6 +19,14 @@ public:
   static void Enter();
   void enter();
 
+  //batched synchronization (config().coprocessor.sync_window): the DSP may run up
+  //to that many clocks ahead of the S-CPU, but catches the S-CPU up first before
+  //any instruction that touches DR, SR, or data RAM when it is mapped to the bus.
+  //the S-CPU only sees the DSP through those, so this is exact.
+  int64 sync_window;
+  bool datamapped;
+  bool shared(uint24 opcode) const;
+
   void exec_op(uint24 opcode);
   void exec_rt(uint24 opcode);
   void exec_jp(uint24 opcode);
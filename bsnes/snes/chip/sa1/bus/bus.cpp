@@ -96,6 +96,17 @@ void VSPROM::write(unsigned addr, uint8 data) {
   memory::cartrom.write(addr, data);
 }
 
+//every page but the one holding the vectors reads as plain ROM, so both the
+//S-CPU and the SA-1 can fetch code from it without calling read()
+uint8* VSPROM::host_data(unsigned offset) {
+  if((offset & 0xffff00) == 0x007f00) return 0;
+  return memory::cartrom.host_data(offset);
+}
+
+DirtyPages* VSPROM::host_pages() {
+  return memory::cartrom.host_pages();
+}
+
 //=======
 //SA1IRAM
 //=======
@@ -16,6 +16,8 @@ struct VSPROM : Memory {
   unsigned size() const;
   alwaysinline uint8 read(unsigned);
   alwaysinline void write(unsigned, uint8);
+  uint8* host_data(unsigned);
+  DirtyPages* host_pages();
 };
 
 struct CPUIRAM : Memory {
@@ -26,8 +26,7 @@ void SA1::enter() {
 
     if(mmio.sa1_rdyb || mmio.sa1_resb) {
       //SA-1 co-processor is asleep
-      tick();
-      synchronize_cpu();
+      idle();
       continue;
     }
 
@@ -86,10 +85,46 @@ bool SA1::interrupt_pending() {
   return status.interrupt_pending;
 }
 
+//SA-1 is asleep: only the S-CPU can wake it, so every tick until the S-CPU
+//next needs to run is taken at once. the last tick is taken normally, so that
+//the S-CPU resumes at the same point it would have otherwise.
+void SA1::idle() {
+  if(clock < 0) {
+    uint64 span = 2 * (uint64)cpu.frequency;
+    unsigned ticks = (-clock + span - 1) / span - 1;
+    if(ticks) {
+      step(ticks * 2);
+      status.tick_counter += ticks;
+      if(mmio.hen || mmio.ven) {
+        while(ticks--) tick_counters();
+      } else if(mmio.hvselb == 0) {
+        while(true) {
+          unsigned wrap = status.hcounter < 1364 ? (1364 - status.hcounter + 1) / 2 : 1;
+          if(ticks < wrap) break;
+          ticks -= wrap;
+          status.hcounter = 0;
+          if(++status.vcounter >= status.scanlines) status.vcounter = 0;
+        }
+        status.hcounter += ticks * 2;
+      } else {
+        unsigned counter = (status.vcounter << 11) + status.hcounter + ticks * 2;
+        status.hcounter = counter & 0x07ff;
+        status.vcounter = (counter >> 11) & 0x01ff;
+      }
+    }
+  }
+
+  tick();
+  synchronize_cpu();
+}
+
 void SA1::tick() {
   step(2);
   if(++status.tick_counter == 0) synchronize_cpu();
+  tick_counters();
+}
 
+void SA1::tick_counters() {
   //adjust counters:
   //note that internally, status counters are in clocks;
   //whereas MMIO register counters are in dots (4 clocks = 1 dot)
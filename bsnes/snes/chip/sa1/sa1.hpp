@@ -20,7 +20,9 @@ public:
   static void Enter();
   void enter();
   debugvirtual void interrupt(uint16 vector);
+  void idle();
   void tick();
+  alwaysinline void tick_counters();
   
   // used by the SA-1 debugger prior to executing instructions
   debugvirtual void op_step() {};
@@ -15,7 +15,7 @@ void SA1::serialize(serializer &s) {
   s.integer(status.hcounter);
 
   //bus/bus.hpp
-  s.array(memory::iram.data(), memory::iram.size());
+  memory::iram.serialize(s);
 
   s.integer(memory::cc1bwram.dma);
 
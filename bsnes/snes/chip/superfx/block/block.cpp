@@ -0,0 +1,54 @@
+#ifdef SUPERFX_CPP
+
+//a block ends after an opcode that writes R15, stops the GSU or changes PBR,
+//when the scheduler wants to synchronize, or after MaxLength opcodes.
+//code in RAM that is not cached is left to the per-opcode loop.
+bool SuperFX::block_run() {
+  uint16 offset = regs.r[15] - regs.cbr;
+  if(offset >= 512 && regs.pbr >= 0x60) return false;
+  if(!block_allowed()) return false;
+
+  uint8 pbr = regs.pbr;
+  block.active = true;
+  block.first = regs.r[15];
+  block.count = 0;
+  do {
+    Block::Opcode &op = block.opcode[block.count++];
+    op.pc = block.last;
+    op.alt = (regs.sfr.alt2 << 1) | (regs.sfr.alt1 << 0);
+
+    uint8 opcode = regs.pipeline;
+    regs.pipeline = block_fetch(regs.r[15]);
+    r15_modified = false;
+    op_exec(opcode);
+    if(r15_modified) break;
+    regs.r[15]++;
+  } while(block.count < Block::MaxLength && regs.sfr.g && regs.pbr == pbr
+       && scheduler.mode != Scheduler::Mode::Synchronize);
+  block.active = false;
+
+  block_flush();
+  block_executed();
+  return true;
+}
+
+//cache hits only add to the pending clocks, up to the point where the GSU
+//would catch up with the S-CPU: until then nothing else can observe them.
+//every other fetch goes through op_read(), whose add_clocks() takes the
+//pending clocks along.
+uint8 SuperFX::block_fetch(uint16 addr) {
+  block.last = addr;
+  uint16 offset = addr - regs.cbr;
+  if(offset < 512 && cache.valid[offset >> 4]) {
+    block.pending += cache_access_speed();
+    if(clock + (int64)block.pending * cpu.frequency >= 0) block_flush();
+    return cache.buffer[offset];
+  }
+  return SuperFX::op_read(addr);
+}
+
+void SuperFX::block_flush() {
+  if(block.pending) add_clocks(0);
+}
+
+#endif
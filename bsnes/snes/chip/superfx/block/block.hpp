@@ -0,0 +1,25 @@
+//block execution: straight-line code in the instruction cache or ROM runs
+//without the per-opcode debugger hooks, and cache fetch clocks are applied in
+//one step as long as the GSU stays behind the S-CPU.
+struct Block {
+  enum : unsigned { MaxLength = 64 };
+
+  bool active;
+  unsigned pending;   //cache fetch clocks not yet passed to add_clocks()
+  uint16 first;       //address of the first byte fetched by the block
+  uint16 last;        //address of the last byte fetched
+  unsigned count;     //opcodes executed
+  struct Opcode {
+    uint16 pc;        //where it was fetched from (opcode 0: before the block)
+    uint8 alt;        //alt2:alt1 when it executed
+  } opcode[MaxLength];
+} block;
+
+bool block_run();
+alwaysinline uint8 block_fetch(uint16 addr);
+alwaysinline void block_flush();
+
+//the debugger disables blocks while it steps or has exec breakpoints,
+//and records opcode usage for each block once it has run
+debugvirtual bool block_allowed() { return true; }
+debugvirtual void block_executed() {}
@@ -88,10 +88,11 @@ void SuperFX::pixelcache_flush(pixelcache_t &cache) {
   unsigned bpp = 2 << (regs.scmr.md - (regs.scmr.md >> 1));  // = [regs.scmr.md]{ 2, 4, 4, 8 };
   unsigned addr = 0x700000 + (cn * (bpp << 3)) + (regs.scbr << 10) + ((y & 0x07) * 2);
 
+  uint64 planes = pixelcache_planes(cache);
+
   for(unsigned n = 0; n < bpp; n++) {
     unsigned byte = ((n >> 1) << 4) + (n & 1);  // = [n]{ 0, 1, 16, 17, 32, 33, 48, 49 };
-    uint8 data = 0x00;
-    for(unsigned x = 0; x < 8; x++) data |= ((cache.data[x] >> n) & 1) << x;
+    uint8 data = planes >> (n << 3);
     if(cache.bitpend != 0xff) {
       add_clocks(memory_access_speed());
       data &= cache.bitpend;
@@ -104,4 +105,12 @@ void SuperFX::pixelcache_flush(pixelcache_t &cache) {
   cache.bitpend = 0x00;
 }
 
+//transposes the eight pixels of a cache row into bitplanes 0-7 (bytes 0-7 of
+//the result), with pixel x in bit x of each plane
+uint64 SuperFX::pixelcache_planes(const pixelcache_t &cache) {
+  uint64 planes = 0;
+  for(unsigned x = 0; x < 8; x++) planes |= pixelcache_table[cache.data[x]] << x;
+  return planes;
+}
+
 #endif
@@ -4,6 +4,8 @@ uint8 color(uint8 source);
 void plot(uint8 x, uint8 y);
 uint8 rpix(uint8 x, uint8 y);
 void pixelcache_flush(pixelcache_t &cache);
+uint64 pixelcache_planes(const pixelcache_t &cache);
+uint64 pixelcache_table[256];  //bit n of each color in bit 8n
 
 //opcode_table.cpp
 inline void op_exec(uint8 opcode);
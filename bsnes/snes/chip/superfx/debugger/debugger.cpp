@@ -5,6 +5,17 @@ void SFXDebugger::reset() {
   
   pc_valid = false;
   opcode_pc = 0;
+
+  for(unsigned n = 0; n < 512; n++) rom_offsets[n].addr = ~0;
+}
+
+int SFXDebugger::rom_offset(unsigned addr) {
+  RomOffset &entry = rom_offsets[addr & 511];
+  if(entry.addr != addr) {
+    entry.addr = addr;
+    entry.offset = cartridge.rom_offset(addr);
+  }
+  return entry.offset;
 }
 
 void SFXDebugger::op_step() {
@@ -31,12 +42,43 @@ uint8 SFXDebugger::op_read(uint16 addr) {
   opcode_pc = addr + (regs.pbr << 16);
   usage[opcode_pc] |= UsageExec;
   
-  int offset = cartridge.rom_offset(opcode_pc);
+  int offset = rom_offset(opcode_pc);
   if (offset >= 0) (*cart_usage)[offset] |= UsageExec;
   
   return SuperFX::op_read(addr);
 }
 
+bool SFXDebugger::block_allowed() {
+  if(debugger.step_sfx || step_event) return false;
+  for(unsigned i = 0; i < debugger.breakpoint.size(); i++) {
+    const Debugger::Breakpoint &bp = debugger.breakpoint[i];
+    if(bp.source == Debugger::Breakpoint::Source::SFXBus
+    && (bp.mode & (unsigned)Debugger::Breakpoint::Mode::Exec)) return false;
+  }
+  return true;
+}
+
+void SFXDebugger::block_executed() {
+  // fetches within a block are sequential
+  uint24 bank = regs.pbr << 16;
+  for(uint16 addr = block.first;; addr++) {
+    usage[bank + addr] |= UsageExec;
+    int offset = rom_offset(bank + addr);
+    if (offset >= 0) (*cart_usage)[offset] |= UsageExec;
+    if(addr == block.last) break;
+  }
+
+  for(unsigned n = 0; n < block.count; n++) {
+    if(n == 0 && !pc_valid) continue;
+    uint24 pc = n ? bank + block.opcode[n].pc : (unsigned)opcode_pc;
+    usage[pc] &= ~(UsageFlagA2 | UsageFlagA1);
+    usage[pc] |= UsageOpcode | block.opcode[n].alt;
+  }
+
+  pc_valid = true;
+  opcode_pc = bank + block.last;
+}
+
 uint8 SFXDebugger::rombuffer_read() {
   uint32 fulladdr = (regs.rombr << 16) + regs.r[14];
   usage[fulladdr] |= UsageRead;
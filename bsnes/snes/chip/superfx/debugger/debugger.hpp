@@ -49,6 +49,10 @@ public:
   
   // mark pipelined instruction bytes as executed and update last pipeline read address
   uint8 op_read(uint16 addr);
+
+  // run blocks only when nothing needs to see each opcode, and mark their usage afterwards
+  bool block_allowed();
+  void block_executed();
   
   // mark (and break on) buffered i/o
   uint8 rombuffer_read();
@@ -58,4 +62,12 @@ public:
 
   SFXDebugger();
   ~SFXDebugger();
+
+private:
+  // cartridge.rom_offset() of recently executed addresses
+  struct RomOffset {
+    unsigned addr;
+    int offset;
+  } rom_offsets[512];
+  int rom_offset(unsigned addr);
 };
@@ -39,7 +39,7 @@ uint8 SuperFX::peekpipe() {
 
 uint8 SuperFX::pipe() {
   uint8 result = regs.pipeline;
-  regs.pipeline = op_read(++regs.r[15]);
+  regs.pipeline = block.active ? block_fetch(++regs.r[15]) : op_read(++regs.r[15]);
   r15_modified = false;
   return result;
 }
@@ -9,6 +9,7 @@ namespace SNES {
 #include "memory/memory.cpp"
 #include "mmio/mmio.cpp"
 #include "timing/timing.cpp"
+#include "block/block.cpp"
 #include "disasm/disasm.cpp"
 
 #if defined(DEBUGGER)
@@ -25,10 +26,12 @@ void SuperFX::enter() {
     scheduler.synchronize();
 
     if(regs.sfr.g == 0) {
-      add_clocks(6);
+      idle();
       continue;
     }
 
+    if(block_run()) continue;
+
     op_step();
 
     op_exec(peekpipe());
@@ -37,6 +40,11 @@ void SuperFX::enter() {
 }
 
 void SuperFX::init() {
+  for(unsigned color = 0; color < 256; color++) {
+    pixelcache_table[color] = 0;
+    for(unsigned n = 0; n < 8; n++) pixelcache_table[color] |= (uint64)((color >> n) & 1) << (n << 3);
+  }
+
   regs.r[14].on_modify = { &SuperFX::r14_modify, this };
   regs.r[15].on_modify = { &SuperFX::r15_modify, this };
 }
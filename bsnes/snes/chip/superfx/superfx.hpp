@@ -6,6 +6,7 @@ public:
   #include "memory/memory.hpp"
   #include "mmio/mmio.hpp"
   #include "timing/timing.hpp"
+  #include "block/block.hpp"
   #include "disasm/disasm.hpp"
 
   static void Enter();
@@ -9,7 +9,11 @@ unsigned SuperFX::memory_access_speed() {
   return regs.clsr.divider + 4;
 }
 
+//also applies the cache fetch clocks a block has left pending
 void SuperFX::add_clocks(unsigned clocks) {
+  clocks += block.pending;
+  block.pending = 0;
+
   if(regs.romcl) {
     regs.romcl -= min(clocks, regs.romcl);
     if(regs.romcl == 0) {
@@ -29,11 +33,22 @@ void SuperFX::add_clocks(unsigned clocks) {
   synchronize_cpu();
 }
 
+//GSU is stopped: nothing can set GO again until the S-CPU runs, so rather than
+//stepping 6 clocks at a time, catch up to the S-CPU in a single step.
+//pending buffer accesses are stepped normally to keep their order intact.
+void SuperFX::idle() {
+  if(regs.romcl || regs.ramcl || clock >= 0) return add_clocks(6);
+  uint64 step = 6 * (uint64)cpu.frequency;
+  add_clocks(6 * ((-clock + step - 1) / step));
+}
+
 void SuperFX::rombuffer_sync() {
+  block_flush();
   if(regs.romcl) add_clocks(regs.romcl);
 }
 
 void SuperFX::rombuffer_update() {
+  block_flush();
   regs.sfr.r = 1;
   regs.romcl = memory_access_speed();
 }
@@ -44,6 +59,7 @@ uint8 SuperFX::rombuffer_read() {
 }
 
 void SuperFX::rambuffer_sync() {
+  block_flush();
   if(regs.ramcl) add_clocks(regs.ramcl);
 }
 
@@ -71,6 +87,9 @@ void SuperFX::r15_modify(uint16 data) {
 
 void SuperFX::timing_reset() {
   r15_modified = false;
+  block.active = false;
+  block.pending = 0;
+  block.last = 0x0000;
 
   regs.romcl = 0;
   regs.romdr = 0;
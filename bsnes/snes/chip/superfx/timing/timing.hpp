@@ -4,6 +4,7 @@ inline unsigned memory_access_speed();
 bool r15_modified;
 
 void add_clocks(unsigned clocks);
+void idle();
 
 void rombuffer_sync();
 void rombuffer_update();
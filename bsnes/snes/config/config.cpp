@@ -21,9 +21,14 @@ Configuration::Configuration() {
 
   smp.ntsc_frequency = 24607104;   //32040.5 * 768
   smp.pal_frequency  = 24607104;
+  smp.relaxed_sync   = false;
+
+  coprocessor.sync_window = 0;
+  coprocessor.dsp1.assign("lle");
 
   ppu1.version = 1;
   ppu2.version = 3;
+  ppu2.render_thread = false;
 
   path.bsxdat = "./bsxdat/";
   
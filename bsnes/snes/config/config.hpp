@@ -17,14 +17,21 @@ struct Configuration {
   struct SMP {
     unsigned ntsc_frequency;
     unsigned pal_frequency;
+    bool relaxed_sync;
   } smp;
 
+  struct Coprocessor {
+    unsigned sync_window;
+    string dsp1;  //"lle", "hle" or "verify"; overridden by <necdsp emulation=...>
+  } coprocessor;
+
   struct PPU1 {
     unsigned version;
   } ppu1;
 
   struct PPU2 {
     unsigned version;
+    bool render_thread;
   } ppu2;
 
   struct Path {
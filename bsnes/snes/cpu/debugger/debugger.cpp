@@ -88,7 +88,7 @@ void CPUDebugger::op_step() {
   }
 
   CPU::op_step();
-  synchronize_smp();
+  if(smp.sync.relaxed == false || debugger.step_cpu || debugger.step_smp) synchronize_smp();
   
   if (debugger.step_cpu) {
     uint8 hvb_new = hvbjoy();
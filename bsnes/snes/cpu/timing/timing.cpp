@@ -11,10 +11,51 @@ unsigned CPU::joypad_counter() {
   return counter.cpu & 255;
 }
 
+//returns how many of the following ticks are known to have no effect besides
+//advancing the counters: no scanline or joypad edge, and every NMI/IRQ poll
+//would leave its state as it is. those ticks can be taken in a single step.
+unsigned CPU::quiet_ticks() {
+  //for the first ten clocks of a scanline, the polls see counters of the previous one
+  unsigned h = hcounter();
+  if(h < 8) return 0;
+  if(input.iobit || status.nmi_hold || status.irq_hold) return 0;
+  if(status.nmi_valid != (vcounter() >= (!ppu.overscan() ? 225 : 240))) return 0;
+
+  bool irq_enabled = status.virq_enabled || status.hirq_enabled;
+  if(status.irq_line && irq_enabled && !status.irq_transition) return 0;
+
+  //last position before the scanline edge
+  unsigned horizon = lineclocks() - 2;
+
+  //value poll_irq() computes at every position in the range, except the H-IRQ dot
+  bool irq_valid = false;
+  if(irq_enabled && (!status.virq_enabled || vcounter() == status.virq_pos)) {
+    if(!status.hirq_enabled) {
+      irq_valid = true;
+    } else {
+      unsigned position = (status.hirq_pos + 1) * 4 + 10;
+      if(position > h) horizon = min(horizon, position - 2);
+    }
+  }
+  if(status.irq_valid != irq_valid) return 0;
+
+  if(horizon <= h) return 0;
+  unsigned joypad = (256 - joypad_counter()) >> 1;
+  return min((horizon - h) >> 1, joypad - 1);
+}
+
 void CPU::add_clocks(unsigned clocks) {
   status.irq_lock = false;
   unsigned ticks = clocks >> 1;
-  while(ticks--) {
+  while(ticks) {
+    unsigned quiet = min(quiet_ticks(), ticks);
+    if(quiet) {
+      counter.cpu += quiet << 1;
+      tick(quiet << 1);
+      ticks -= quiet;
+      continue;
+    }
+
     counter.cpu += 2;
     tick();
     if(hcounter() & 2) {
@@ -25,6 +66,7 @@ void CPU::add_clocks(unsigned clocks) {
     if(joypad_counter() == 0) {
       joypad_edge();
     }
+    ticks--;
   }
 
   step(clocks);
@@ -2,6 +2,7 @@
 unsigned dma_counter();
 unsigned joypad_counter();
 
+alwaysinline unsigned quiet_ticks();
 void add_clocks(unsigned clocks);
 void scanline();
 
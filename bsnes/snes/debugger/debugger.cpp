@@ -145,6 +145,7 @@ void Debugger::write(Debugger::MemorySource source, unsigned addr, uint8 data) {
 
     case MemorySource::VRAM: {
       memory::vram.write(addr & 0x3ffff, data);
+      ppu.render_invalidate();
     } break;
 
     case MemorySource::OAM: {
@@ -154,6 +155,7 @@ void Debugger::write(Debugger::MemorySource source, unsigned addr, uint8 data) {
 
     case MemorySource::CGRAM: {
       memory::cgram.write(addr & 0x01ff, data);
+      ppu.render_invalidate();
     } break;
     
     case MemorySource::CartROM: {
@@ -2,6 +2,7 @@
 
 bool DSPDebugger::property(unsigned id, string &name, string &value) {
   unsigned n = 0;
+  smp.catch_up_dsp();
 
   #define item(name_, value_) \
   if(id == n++) { \
@@ -26,6 +26,7 @@ namespace SNES {
 /* timing */
 
 void DSP::step(unsigned clocks) {
+  cycles += clocks;
   clock += clocks;
 }
 
@@ -47,8 +48,8 @@ void DSP::enter() {
     scheduler.synchronize();
 #else
   #define PHASE(n) case n:
-  #define TICK return tick()
-  switch(phase & 31) {
+  #define TICK tick(); if(clock >= 0) return
+  while(clock < 0) switch(phase & 31) {
 #endif
     PHASE(0)
     voice_5(voice[0]);
@@ -1,4 +1,9 @@
-#define DSP_THREADED true
+//non-threaded: the S-SMP runs the S-DSP in blocks, catching it up exactly wherever
+//the two interact (see SMP::DSPBlock). build with -DDSP_THREADED=true for a cothread
+//that is resumed on every S-SMP cycle instead.
+#if !defined(DSP_THREADED)
+  #define DSP_THREADED false
+#endif
 
 class DSP : public Processor {
 public:
@@ -13,6 +18,7 @@ public:
   void write(uint8 addr, uint8 data);
   enum { register_count = 128 };
   void load(uint8 const regs [register_count]);
+  unsigned echo_window(uint16 base[2], uint16 &pointer) const;
 
   void enter();
   void power();
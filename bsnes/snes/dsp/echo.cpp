@@ -23,8 +23,8 @@ void DSP::echo_write(bool channel) {
   if(!(state.t_echo_disabled & 0x20)) {
     unsigned addr = state.t_echo_ptr + channel * 2;
     int s = state.t_echo_out[channel];
-    memory::apuram[(uint16)(addr + 0)] = s;
-    memory::apuram[(uint16)(addr + 1)] = s >> 8;
+    memory::apuram.write((uint16)(addr + 0), s);
+    memory::apuram.write((uint16)(addr + 1), s >> 8);
   }
 
   state.t_echo_out[channel] = 0;
@@ -132,4 +132,15 @@ void DSP::echo_30() {
   echo_write(1);
 }
 
+//where echo writes may land until the S-DSP register settings change: size bytes from
+//the latched and the current ESA, plus the four bytes at the current echo pointer.
+//returns 0 when FLG and its latched copy both disable echo writes.
+unsigned DSP::echo_window(uint16 base[2], uint16 &pointer) const {
+  base[0] = state.t_esa << 8;
+  base[1] = REG(esa) << 8;
+  pointer = state.t_echo_ptr;
+  if(state.t_echo_disabled & REG(flg) & 0x20) return 0;
+  return max(4, max(state.echo_length, (REG(edl) & 0x0f) << 11));
+}
+
 #endif
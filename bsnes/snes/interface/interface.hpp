@@ -1,7 +1,12 @@
 class Interface {
 public:
   virtual void video_extras(uint16_t *data, unsigned width, unsigned height) {}
+  //called on the presentation thread instead when Video::set_present_thread(true);
+  //video_extras() and video_frameskip() always run on the emulation thread
   virtual void video_refresh(const uint16_t *data, unsigned width, unsigned height) {}
+  //called once per frame before video_refresh(), with the number of frames the PPU
+  //has skipped since power-on; on a skipped frame, video_refresh() repeats the last picture
+  virtual void video_frameskip(unsigned skipped) {}
   virtual void audio_sample(uint16_t l_sample, uint16_t r_sample) {}
   virtual void input_poll() {}
   virtual int16_t input_poll(bool port, Input::Device device, unsigned index, unsigned id) { return 0; }
@@ -38,7 +38,7 @@ unsigned snes_library_revision_major(void) {
 }
 
 unsigned snes_library_revision_minor(void) {
-  return 1;
+  return 2;
 }
 
 void snes_set_video_refresh(snes_video_refresh_t video_refresh) {
@@ -91,17 +91,26 @@ unsigned snes_serialize_size(void) {
   return SNES::system.serialize_size();
 }
 
+//states are written to and read from the caller's buffer directly
 bool snes_serialize(uint8_t *data, unsigned size) {
   SNES::system.runtosave();
-  serializer s = SNES::system.serialize();
-  if(s.size() > size) return false;
-  memcpy(data, s.data(), s.size());
-  return true;
+  return SNES::system.serialize(data, size);
 }
 
 bool snes_unserialize(const uint8_t *data, unsigned size) {
-  serializer s(data, size);
-  return SNES::system.unserialize(s);
+  return SNES::system.unserialize(data, size);
+}
+
+unsigned snes_serialize_region_count(void) {
+  return SNES::system.state_regions;
+}
+
+const char* snes_serialize_region(unsigned index, unsigned *offset, unsigned *size) {
+  if(index >= SNES::system.state_regions) return 0;
+  const SNES::System::StateRegion &region = SNES::system.state_region[index];
+  if(offset) *offset = region.offset;
+  if(size) *size = region.size;
+  return region.name;
 }
 
 void snes_cheat_reset(void) {
@@ -85,6 +85,8 @@ void snes_run(void);
 unsigned snes_serialize_size(void);
 bool snes_serialize(uint8_t *data, unsigned size);
 bool snes_unserialize(const uint8_t *data, unsigned size);
+unsigned snes_serialize_region_count(void);
+const char* snes_serialize_region(unsigned index, unsigned *offset, unsigned *size);
 
 void snes_cheat_reset(void);
 void snes_cheat_set(unsigned index, bool enabled, const char *code);
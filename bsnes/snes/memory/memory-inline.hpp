@@ -1,6 +1,8 @@
 //Memory
 
 unsigned Memory::size() const { return 0; }
+uint8* Memory::host_data(unsigned) { return 0; }
+DirtyPages* Memory::host_pages() { return 0; }
 
 bool Memory::debugger_access() {
 #if defined(DEBUGGER)
@@ -10,17 +12,36 @@ bool Memory::debugger_access() {
 #endif
 }
 
+//DirtyPages
+
+void DirtyPages::mark(unsigned addr) { stamp_[addr >> PageBits] = epoch; }
+void DirtyPages::mark_all() { for(unsigned i = 0; i < pages_; i++) stamp_[i] = epoch; }
+bool DirtyPages::writable() const { return writable_; }
+
+void DirtyPages::resize_pages(unsigned size) {
+  if(stamp_) delete[] stamp_;
+  pages_ = (size + PageSize - 1) >> PageBits;
+  stamp_ = pages_ ? new uint32[pages_] : 0;
+  mark_all();
+}
+
+DirtyPages::DirtyPages() : writable_(true), stamp_(0), pages_(0) {}
+DirtyPages::~DirtyPages() { if(stamp_) delete[] stamp_; }
+
 //StaticRAM
 
 uint8* StaticRAM::data() { return data_; }
 unsigned StaticRAM::size() const { return size_; }
 
 uint8 StaticRAM::read(unsigned addr) { return data_[addr]; }
-void StaticRAM::write(unsigned addr, uint8 n) { data_[addr] = n; }
+void StaticRAM::write(unsigned addr, uint8 n) { data_[addr] = n; mark(addr); }
 uint8& StaticRAM::operator[](unsigned addr) { return data_[addr]; }
 const uint8& StaticRAM::operator[](unsigned addr) const { return data_[addr]; }
+void StaticRAM::serialize(serializer &s) { serialize_pages(s, data_, size_); }
+uint8* StaticRAM::host_data(unsigned) { return data_; }
+DirtyPages* StaticRAM::host_pages() { return this; }
 
-StaticRAM::StaticRAM(unsigned n) : size_(n) { data_ = new uint8[size_]; }
+StaticRAM::StaticRAM(unsigned n) : size_(n) { data_ = new uint8[size_]; resize_pages(size_); }
 StaticRAM::~StaticRAM() { delete[] data_; }
 
 //MappedRAM
@@ -31,13 +52,15 @@ void MappedRAM::reset() {
     data_ = 0;
   }
   size_ = 0;
-  write_protect_ = false;
+  writable_ = true;
+  resize_pages(0);
 }
 
 void MappedRAM::map(uint8 *source, unsigned length) {
   reset();
   data_ = source;
   size_ = data_ && length > 0 ? length : 0;
+  resize_pages(size_);
 }
 
 void MappedRAM::copy(const uint8 *data, unsigned size) {
@@ -46,16 +69,20 @@ void MappedRAM::copy(const uint8 *data, unsigned size) {
     data_ = new uint8[size_]();
   }
   memcpy(data_, data, min(size_, size));
+  resize_pages(size_);
 }
 
-void MappedRAM::write_protect(bool status) { write_protect_ = status; }
+void MappedRAM::write_protect(bool status) { writable_ = !status; }
 uint8* MappedRAM::data() { return data_; }
 unsigned MappedRAM::size() const { return size_; }
 
 uint8 MappedRAM::read(unsigned addr) { return data_[addr]; }
-void MappedRAM::write(unsigned addr, uint8 n) { if(!write_protect_ || debugger_access()) data_[addr] = n; }
+void MappedRAM::write(unsigned addr, uint8 n) { if(writable_ || debugger_access()) { data_[addr] = n; mark(addr); } }
 const uint8& MappedRAM::operator[](unsigned addr) const { return data_[addr]; }
-MappedRAM::MappedRAM() : data_(0), size_(0), write_protect_(false) {}
+void MappedRAM::serialize(serializer &s) { serialize_pages(s, data_, size_); }
+uint8* MappedRAM::host_data(unsigned) { return data_; }
+DirtyPages* MappedRAM::host_pages() { return this; }
+MappedRAM::MappedRAM() : data_(0), size_(0) {}
 
 //VRAM
 
@@ -95,6 +122,12 @@ uint8& VRAM::operator[](unsigned addr) {
   // non-accuracy PPU still uses uint16 for VRAM addresses, no casting/masking needed here
   return access_[addr];
 }
+
+void VRAM::assign(unsigned addr, uint8 n) {
+  uint8 &target = operator[](addr);
+  target = n;
+  mark(&target - data());
+}
 VRAM::VRAM() : MappedRAM() { reset(); }
 
 //Bus
@@ -107,11 +140,18 @@ uint8 Bus::read(uint24 addr) {
   }
   #endif
   Page &p = page[addr >> 8];
+  if(p.data) return p.data[p.offset + addr];
   return p.access->read(p.offset + addr);
 }
 
 void Bus::write(uint24 addr, uint8 data) {
   Page &p = page[addr >> 8];
+  if(p.data && p.pages->writable()) {
+    unsigned offset = p.offset + addr;
+    p.data[offset] = data;
+    p.pages->mark(offset);
+    return;
+  }
   p.access->write(p.offset + addr, data);
 }
 
@@ -80,6 +80,8 @@ void Bus::map(unsigned addr, Memory &access, unsigned offset) {
   Page &p = page[addr >> 8];
   p.access = &access;
   p.offset = offset - addr;
+  p.data = access.host_data(offset);
+  p.pages = p.data ? access.host_pages() : 0;
 }
 
 void Bus::map(
@@ -141,7 +143,9 @@ bool Bus::load_cart() {
   return true;
 }
 
+//cartridge memory is freed on unload: drop the host pointers that refer to it
 void Bus::unload_cart() {
+  map_reset();
 }
 
 void Bus::map_reset() {
@@ -175,6 +179,7 @@ void Bus::map_system() {
 
 void Bus::power() {
   foreach(n, memory::wram) n = random(config().cpu.wram_init_value);
+  memory::wram.mark_all();
 }
 
 void Bus::reset() {
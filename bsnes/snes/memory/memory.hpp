@@ -1,8 +1,41 @@
+struct DirtyPages;
+
 struct Memory {
   virtual inline unsigned size() const;
   virtual uint8 read(unsigned addr) = 0;
   virtual void write(unsigned addr, uint8 data) = 0;
   static alwaysinline bool debugger_access();
+
+  //plain arrays (StaticRAM, MappedRAM) expose the buffer read() and write() index,
+  //so that Bus pages mapped to them can skip the virtual calls. offset is the
+  //first address of the page being mapped; 0 keeps that page on read()/write().
+  virtual inline uint8* host_data(unsigned offset);
+  virtual inline DirtyPages* host_pages();
+};
+
+//page-granular write tracking for incremental savestates (System::serialize_delta):
+//every 256-byte page records the epoch in which it was last written
+struct DirtyPages {
+  enum : unsigned { PageBits = 8, PageSize = 1 << PageBits };
+  static uint32 epoch;  //stamped onto written pages; advanced after every savestate
+  static uint32 since;  //delta savestates store only pages stamped at or after this epoch
+  static bool delta;    //set while a delta savestate is being saved or loaded
+
+  inline void mark(unsigned addr);
+  inline void mark_all();
+  inline bool writable() const;  //false while write protected
+
+protected:
+  bool writable_;
+
+  inline void resize_pages(unsigned size);
+  void serialize_pages(serializer&, uint8 *data, unsigned size);
+  inline DirtyPages();
+  inline ~DirtyPages();
+
+private:
+  uint32 *stamp_;
+  unsigned pages_;
 };
 
 struct MMIO {
@@ -21,7 +54,8 @@ struct UnmappedMMIO : MMIO {
   void mmio_write(unsigned, uint8);
 };
 
-struct StaticRAM : Memory {
+//operator[] does not mark pages dirty: use write() to modify contents
+struct StaticRAM : Memory, DirtyPages {
   inline uint8* data();
   inline unsigned size() const;
 
@@ -29,6 +63,9 @@ struct StaticRAM : Memory {
   inline void write(unsigned addr, uint8 n);
   inline uint8& operator[](unsigned addr);
   inline const uint8& operator[](unsigned addr) const;
+  inline void serialize(serializer&);
+  inline uint8* host_data(unsigned offset);
+  inline DirtyPages* host_pages();
 
   inline StaticRAM(unsigned size);
   inline ~StaticRAM();
@@ -38,7 +75,7 @@ private:
   unsigned size_;
 };
 
-struct MappedRAM : Memory {
+struct MappedRAM : Memory, DirtyPages {
   inline void reset();
   inline void map(uint8*, unsigned);
   inline void copy(const uint8*, unsigned);
@@ -50,12 +87,14 @@ struct MappedRAM : Memory {
   inline uint8 read(unsigned addr);
   inline void write(unsigned addr, uint8 n);
   inline const uint8& operator[](unsigned addr) const;
+  inline void serialize(serializer&);
+  inline uint8* host_data(unsigned offset);
+  inline DirtyPages* host_pages();
   inline MappedRAM();
 
 private:
   uint8 *data_;
   unsigned size_;
-  bool write_protect_;
 };
 
 struct VRAM : MappedRAM {
@@ -65,6 +104,7 @@ struct VRAM : MappedRAM {
   inline void bank(bool enable, unsigned num = 0);
   
   inline uint8& operator[](unsigned addr);
+  inline void assign(unsigned addr, uint8 n);  //banked write, as operator[]
   inline VRAM();
 
 private:
@@ -107,9 +147,13 @@ struct Bus {
   void power();
   void reset();
 
+  //data and pages are set for StaticRAM and MappedRAM: reads index data directly,
+  //and so do writes while the memory is writable. everything else calls access.
   struct Page {
     Memory *access;
     unsigned offset;
+    uint8 *data;
+    DirtyPages *pages;
   } page[65536];
 
   void serialize(serializer&);
@@ -1,11 +1,43 @@
 #ifdef MEMORY_CPP
 
+uint32 DirtyPages::epoch = 1;
+uint32 DirtyPages::since = 0;
+bool DirtyPages::delta = false;
+
+//full savestates store the array as-is. delta savestates store, for every
+//group of eight pages, a bitmask of the pages written since the requested
+//epoch followed by those pages; Size mode reserves room for all of them.
+void DirtyPages::serialize_pages(serializer &s, uint8 *data, unsigned size) {
+  if(delta == false) {
+    s.array(data, size);
+    if(s.mode() == serializer::Load) mark_all();
+    return;
+  }
+
+  for(unsigned base = 0; base < pages_; base += 8) {
+    uint8 mask = 0;
+    if(s.mode() == serializer::Save) {
+      for(unsigned n = 0; n < 8 && base + n < pages_; n++) {
+        if(stamp_[base + n] >= since) mask |= 1 << n;
+      }
+    }
+    s.integer(mask);
+
+    for(unsigned n = 0; n < 8 && base + n < pages_; n++) {
+      if(s.mode() != serializer::Size && !(mask & (1 << n))) continue;
+      unsigned offset = (base + n) << PageBits;
+      s.array(data + offset, min((unsigned)PageSize, size - offset));
+      if(s.mode() == serializer::Load) stamp_[base + n] = epoch;
+    }
+  }
+}
+
 void Bus::serialize(serializer &s) {
-  s.array(memory::wram.data(), memory::wram.size());
-  s.array(memory::apuram.data(), memory::apuram.size());
-  s.array(memory::vram.data(), memory::vram.size());
-  s.array(memory::oam.data(), memory::oam.size());
-  s.array(memory::cgram.data(), memory::cgram.size());
+  system.serialize_region(s, "wram"); memory::wram.serialize(s);
+  system.serialize_region(s, "apuram"); memory::apuram.serialize(s);
+  system.serialize_region(s, "vram"); memory::vram.serialize(s);
+  system.serialize_region(s, "oam"); memory::oam.serialize(s);
+  system.serialize_region(s, "cgram"); memory::cgram.serialize(s);
 }
 
 #endif
@@ -39,7 +39,7 @@ uint8 PPU::vram_read(unsigned addr) {
 
 void PPU::vram_write(unsigned addr, uint8 data) {
   if(regs.display_disable || vcounter() >= (!regs.overscan ? 225 : 240)) {
-    memory::vram[addr] = data;
+    memory::vram.assign(addr, data);
   }
 }
 
@@ -60,7 +60,7 @@ uint8 PPU::cgram_read(unsigned addr) {
 
 void PPU::cgram_write(unsigned addr, uint8 data) {
   // address/data are handled by mmio_w2122
-  memory::cgram[addr] = data;
+  memory::cgram.write(addr, data);
 }
 
 void PPU::mmio_update_video_mode() {
@@ -18,6 +18,7 @@ namespace SNES {
 #include "serialization.cpp"
 
 void PPU::step(unsigned clocks) {
+  cycles += clocks;
   clock += clocks;
 }
 
@@ -94,6 +95,7 @@ void PPU::power() {
     memory::cgram.write(i, random(0));
   }
   memset(memory::oam.data(), 0x00, memory::oam.size());
+  memory::oam.mark_all();
 
   reset();
 }
@@ -147,6 +149,13 @@ void PPU::frame() {
   if (display.overscan && !regs.overscan)
     memset(output + 225 * 1024, 0, 15 * 1024 * sizeof(uint16));
   display.overscan = regs.overscan;
+
+  framecounter = (frameskip == 0 ? 0 : (framecounter + 1) % frameskip);
+}
+
+void PPU::set_frameskip(unsigned frameskip_) {
+  frameskip = frameskip_;
+  framecounter = 0;
 }
 
 PPU::PPU() :
@@ -159,6 +168,8 @@ window(*this),
 screen(*this) {
   surface = new uint16[512 * 512];
   output = surface + 16 * 512;
+  frameskip = 0;
+  framecounter = 0;
 }
 
 PPU::~PPU() {
@@ -2,8 +2,9 @@ class PPU : public Processor, public PPUcounter, public MMIO {
 public:
   enum : bool { Threaded = true };
   enum : bool { SupportsLayerEnable = false };
-  enum : bool { SupportsFrameSkip = false };
+  enum : bool { SupportsFrameSkip = true };
   enum : bool { SupportsVRAMExpansion = true };
+  enum : bool { SupportsRenderThread = false };
 
   alwaysinline void step(unsigned clocks);
   alwaysinline void synchronize_cpu();
@@ -18,9 +19,14 @@ public:
   void reset();
 
   void layer_enable(unsigned, unsigned, bool) {}
-  bool frame_skipped() const { return false; }
-  unsigned get_frameskip() const { return 0; }
-  void set_frameskip(unsigned) {}
+  bool frame_skipped() const { return framecounter > 0; }
+  unsigned get_frameskip() const { return frameskip; }
+  void set_frameskip(unsigned);
+
+  void set_render_thread(bool) {}
+  bool get_render_thread() const { return false; }
+  void render_join() {}
+  void render_invalidate() {}
 
   void serialize(serializer&);
   PPU();
@@ -33,6 +39,10 @@ private:
   uint8 ppu1_version;
   uint8 ppu2_version;
 
+  //frameskip only bypasses pixel composition (see Screen::render), so it does not affect emulation
+  unsigned frameskip;
+  unsigned framecounter;
+
   struct {
     bool interlace;
     bool overscan;
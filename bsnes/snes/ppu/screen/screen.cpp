@@ -1,6 +1,7 @@
 #ifdef PPU_CPP
 
 void PPU::Screen::scanline() {
+  render = !self.frame_skipped() && system.render_video();
   output = self.output + self.vcounter() * 1024;
   if(self.display.interlace && self.field()) output += 512;
 
@@ -21,6 +22,7 @@ void PPU::Screen::run() {
   bool hires = self.regs.pseudo_hires || self.regs.bgmode == 5 || self.regs.bgmode == 6;
   uint16 sscolor = get_pixel_sub(hires);
   uint16 mscolor = get_pixel_main();
+  if(!render) return;
   *output++ = light_table[self.regs.display_brightness][hires ? sscolor : mscolor];
   *output++ = light_table[self.regs.display_brightness][mscolor];
 }
@@ -55,7 +57,7 @@ uint16 PPU::Screen::get_pixel_sub(bool hires) {
   }
   if(math.transparent = (priority == 0)) math.sub.color = get_color(0);
 
-  if(!hires) return 0;
+  if(!hires || !render) return 0;
   if(!math.sub.color_enable) return math.main.color_enable ? math.sub.color : 0;
   return addsub(math.main.color_enable ? math.sub.color : 0,
                 math.addsub_mode ? math.main.color : regs.color);
@@ -111,6 +113,7 @@ uint16 PPU::Screen::get_pixel_main() {
     math.color_halve = regs.color_halve && math.main.color_enable;
   }
 
+  if(!render) return 0;
   return addsub(math.main.color_enable ? math.main.color : 0,
                 math.addsub_mode ? math.sub.color : regs.color);
 }
@@ -170,9 +173,11 @@ void PPU::Screen::reset() {
   math.sub.color_enable = false;
   math.addsub_mode = false;
   math.color_halve = false;
+  render = true;
 }
 
 PPU::Screen::Screen(PPU &self) : self(self) {
+  render = true;
   for(unsigned l = 0; l < 16; l++) {
     for(unsigned r = 0; r < 32; r++) {
       for(unsigned g = 0; g < 32; g++) {
@@ -1,5 +1,6 @@
 class Screen {
   uint16 *output;
+  bool render;  //false on skipped frames: only the state visible to the S-CPU is updated
 
   struct Regs {
     bool addsub_mode;
@@ -1,7 +1,7 @@
 #ifdef PPU_CPP
 
 void PPU::Sprite::update(unsigned addr, uint8 data) {
-  memory::oam[addr] = data;
+  memory::oam.write(addr, data);
 
   if(addr < 0x0200) {
     unsigned n = addr >> 2;
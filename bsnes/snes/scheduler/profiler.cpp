@@ -0,0 +1,176 @@
+#ifdef SYSTEM_CPP
+
+Profiler profiler;
+
+void Profiler::Counters::reset() {
+  memset(time, 0, sizeof time);
+  memset(switches, 0, sizeof switches);
+}
+
+void Profiler::Counters::add(const Counters &source) {
+  for(unsigned i = 0; i < Slots; i++) {
+    time[i] += source.time[i];
+    for(unsigned n = 0; n < Slots; n++) switches[i][n] += source.switches[i][n];
+  }
+}
+
+void Profiler::enable(bool state) {
+  if(enabled == state) return;
+  enabled = state;
+  if(enabled) reset();  //keep counters readable after disabling
+}
+
+void Profiler::reset() {
+  current.reset();
+  frame.reset();
+  total.reset();
+  frames = 0;
+  active = 0;
+  timestamp = now();
+}
+
+string Profiler::name(unsigned slot) const {
+  if(slot == 0 || slot >= slots) return "host";
+  const Processor *chip = processor[slot];
+  if(chip == &cpu) return "CPU";
+  if(chip == &smp) return "SMP";
+  if(chip == &dsp) return "DSP";
+  if(chip == &ppu) return "PPU";
+  if(chip == &bsxbase) return "BSX";
+  if(chip == &supergameboy) return "SuperGameBoy";
+  if(chip == &superfx) return "SuperFX";
+  if(chip == &sa1) return "SA1";
+  if(chip == &necdsp) return "NECDSP";
+  if(chip == &cx4) return "Cx4";
+  if(chip == &msu1) return "MSU1";
+  if(chip == &serial) return "Serial";
+  return "?";
+}
+
+string Profiler::report() const {
+  string output;
+  if(frames == 0) return "profiler: no frames recorded\n";
+
+  uint64 time = 0, switches = 0;
+  for(unsigned i = 0; i < slots; i++) {
+    time += total.time[i];
+    for(unsigned n = 0; n < slots; n++) switches += total.switches[i][n];
+  }
+
+  char line[256];
+  sprintf(line, "profiler: %u frames, %.3f ms/frame, %.1f switches/frame\n",
+    frames, time / 1000000.0 / frames, (double)switches / frames);
+  output << line;
+  sprintf(line, "%-14s %10s %7s %10s\n", "thread", "ms/frame", "share", "out/frame");
+  output << line;
+  for(unsigned i = 0; i < slots; i++) {
+    uint64 out = 0;
+    for(unsigned n = 0; n < slots; n++) out += total.switches[i][n];
+    sprintf(line, "%-14s %10.3f %6.1f%% %10.1f\n", (const char*)name(i),
+      total.time[i] / 1000000.0 / frames, time ? total.time[i] * 100.0 / time : 0.0, (double)out / frames);
+    output << line;
+  }
+  output << "switches/frame by pair:\n";
+  for(unsigned i = 0; i < slots; i++) {
+    for(unsigned n = 0; n < slots; n++) {
+      if(total.switches[i][n] == 0) continue;
+      sprintf(line, "  %-12s -> %-12s %10.1f\n", (const char*)name(i), (const char*)name(n),
+        (double)total.switches[i][n] / frames);
+      output << line;
+    }
+  }
+  return output;
+}
+
+//called from Scheduler::init() once the coprocessor list is final.
+//counters survive reset() and unserialize() as long as the chip set is unchanged.
+void Profiler::init() {
+  Processor *list[Slots] = { 0 };
+  unsigned count = 1;
+  list[count++] = &cpu;
+  list[count++] = &smp;
+  list[count++] = &dsp;
+  list[count++] = &ppu;
+  for(unsigned i = 0; i < cpu.coprocessors.size() && count < Slots; i++) {
+    list[count++] = cpu.coprocessors[i];
+  }
+
+  bool changed = count != slots;
+  for(unsigned i = 0; i < count; i++) {
+    if(processor[i] != list[i]) changed = true;
+    processor[i] = list[i];
+  }
+  slots = count;
+  if(changed) reset();
+
+  current.reset();
+  active = 0;
+  timestamp = now();
+}
+
+void Profiler::frame_event() {
+  charge();
+  frame = current;
+  total.add(current);
+  current.reset();
+  frames++;
+}
+
+void Profiler::switch_thread(cothread_t to) {
+  charge();
+  unsigned slot = find(to);
+  current.switches[active][slot]++;
+  active = slot;
+}
+
+unsigned Profiler::enter(Processor &chip) {
+  charge();
+  unsigned previous = active;
+  active = find(chip);
+  return previous;
+}
+
+void Profiler::leave(unsigned slot) {
+  charge();
+  active = slot;
+}
+
+Profiler::Profiler() {
+  enabled = false;
+  slots = 1;
+  memset(processor, 0, sizeof processor);
+  frames = 0;
+  active = 0;
+  timestamp = 0;
+  current.reset();
+  frame.reset();
+  total.reset();
+}
+
+uint64 Profiler::now() const {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+    std::chrono::steady_clock::now().time_since_epoch()
+  ).count();
+}
+
+void Profiler::charge() {
+  uint64 timestamp = now();
+  current.time[active] += timestamp - this->timestamp;
+  this->timestamp = timestamp;
+}
+
+unsigned Profiler::find(cothread_t thread) const {
+  for(unsigned i = 1; i < slots; i++) {
+    if(processor[i]->thread == thread) return i;
+  }
+  return 0;
+}
+
+unsigned Profiler::find(const Processor &chip) const {
+  for(unsigned i = 1; i < slots; i++) {
+    if(processor[i] == &chip) return i;
+  }
+  return 0;
+}
+
+#endif
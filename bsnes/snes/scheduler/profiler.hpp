@@ -0,0 +1,48 @@
+//opt-in scheduler instrumentation: counts co_switch calls per thread pair and
+//accumulates host time spent inside each processor. disabled by default; the
+//only cost when disabled is one branch per context switch.
+
+struct Profiler {
+  enum : unsigned { Slots = 16 };  //slot 0 is the host (program) thread
+
+  struct Counters {
+    uint64 time[Slots];               //host nanoseconds spent in each slot
+    uint64 switches[Slots][Slots];    //co_switch count, [from][to]
+
+    void reset();
+    void add(const Counters&);
+  };
+
+  bool enabled;
+  unsigned slots;
+  Processor *processor[Slots];
+
+  Counters frame;  //last completed frame
+  Counters total;  //every frame since reset()
+  unsigned frames;
+
+  void enable(bool);
+  void reset();
+  string name(unsigned slot) const;
+  string report() const;
+
+  void init();
+  void frame_event();
+  void switch_thread(cothread_t to);
+  unsigned enter(Processor&);  //non-threaded chips: charge time without a switch
+  void leave(unsigned slot);
+
+  Profiler();
+
+private:
+  Counters current;
+  unsigned active;
+  uint64 timestamp;
+
+  uint64 now() const;
+  void charge();
+  unsigned find(cothread_t) const;
+  unsigned find(const Processor&) const;
+};
+
+extern Profiler profiler;
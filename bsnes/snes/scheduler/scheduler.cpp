@@ -4,33 +4,53 @@ Scheduler scheduler;
 
 void Scheduler::enter() {
   host_thread = co_active();
-  co_switch(thread);
+  switch_to(thread);
 }
 
 void Scheduler::exit(ExitReason reason) {
   exit_reason = reason;
   thread = co_active();
-  co_switch(host_thread);
+  if (mode == Mode::Synchronize) {
+    if (reason == ExitReason::SynchronizeEvent) resynchronize(thread);
+    else desynchronize(thread);
+  }
+  switch_to(host_thread);
 }
 
 void Scheduler::resume(cothread_t& thread) {
   if (mode == Mode::Synchronize)
-    desynchronized = true;
-  co_switch(thread);
+    desynchronize(co_active());
+  switch_to(thread);
 }
 
 void Scheduler::init() {
   host_thread = co_active();
   thread = cpu.thread;
-  desynchronized = false;
+  unsynchronized_count = 0;
   mode = Mode::Synchronize;
+  profiler.init();
 }
 
 Scheduler::Scheduler() {
   host_thread = 0;
   thread = 0;
-  desynchronized = false;
+  unsynchronized_count = 0;
   exit_reason = ExitReason::UnknownEvent;
 }
 
+void Scheduler::desynchronize(cothread_t thread) {
+  for (unsigned i = 0; i < unsynchronized_count; i++) {
+    if (unsynchronized[i] == thread) return;
+  }
+  if (unsynchronized_count < Threads) unsynchronized[unsynchronized_count++] = thread;
+}
+
+void Scheduler::resynchronize(cothread_t thread) {
+  for (unsigned i = 0; i < unsynchronized_count; i++) {
+    if (unsynchronized[i] != thread) continue;
+    unsynchronized[i] = unsynchronized[--unsynchronized_count];
+    return;
+  }
+}
+
 #endif
@@ -1,31 +1,39 @@
+#include "profiler.hpp"
+
 struct Scheduler : property<Scheduler> {
   enum class Mode : unsigned { Run, Synchronize } mode;
-  enum class ExitReason : unsigned { UnknownEvent, FrameEvent, SynchronizeEvent, DesynchronizeEvent, DebuggerEvent };
+  enum class ExitReason : unsigned { UnknownEvent, FrameEvent, SynchronizeEvent, DebuggerEvent };
   readonly<ExitReason> exit_reason;
 
   cothread_t host_thread;  //program thread (used to exit emulation)
   cothread_t thread;       //active emulation thread (used to enter emulation)
-  bool desynchronized;
+
+  //Synchronize mode: threads that are suspended somewhere other than at a
+  //synchronization point (inside resume() or a non-synchronize exit())
+  enum : unsigned { Threads = 16 };
+  cothread_t unsynchronized[Threads];
+  unsigned unsynchronized_count;
 
   void enter();
   void exit(ExitReason);
   void resume(cothread_t& thread);
+  void desynchronize(cothread_t);
 
   inline bool synchronizing() const { return mode == Mode::Synchronize; }
   inline void synchronize() {
-    if (mode == Mode::Synchronize) {
-      if (desynchronized) {
-        desynchronized = false;
-        exit(ExitReason::DesynchronizeEvent);
-      } else {
-        exit(ExitReason::SynchronizeEvent);
-      }
-    }
+    if (mode == Mode::Synchronize) exit(ExitReason::SynchronizeEvent);
   }
-  inline void desynchronize() { desynchronized = true; }
 
   void init();
   Scheduler();
+
+private:
+  void resynchronize(cothread_t);
+
+  inline void switch_to(cothread_t to) {
+    if(profiler.enabled) profiler.switch_thread(to);
+    co_switch(to);
+  }
 };
 
 extern Scheduler scheduler;
@@ -36,7 +36,7 @@ void SMPDebugger::op_step() {
   }
   
   SMP::op_step();
-  synchronize_cpu();
+  if(sync.relaxed == false || debugger.step_cpu || debugger.step_smp) synchronize_cpu();
 }
 
 alwaysinline uint8_t SMPDebugger::op_readpc() {
@@ -75,6 +75,7 @@ static string clockdivide(double base, unsigned divide) {
 
 bool SMPDebugger::property(unsigned id, string &name, string &value) {
   unsigned n = 0;
+  sync_timers();
 
   #define item(name_, value_) \
   if(id == n++) { \
@@ -3,12 +3,16 @@
 alwaysinline uint8 SMP::ram_read(uint16 addr) {
   if(addr >= 0xffc0 && status.iplrom_enabled) return iplrom[addr & 0x3f];
   if(status.ram_disabled) return 0x5a;  //0xff on mini-SNES
+  if(DSP::Threaded == false && echo_window.page[addr >> 8] && !Memory::debugger_access()) synchronize_dsp();
   return memory::apuram[addr];
 }
 
 alwaysinline void SMP::ram_write(uint16 addr, uint8 data) {
   //writes to $ffc0-$ffff always go to apuram, even if the iplrom is enabled
-  if(status.ram_writable && !status.ram_disabled) memory::apuram[addr] = data;
+  if(status.ram_writable && !status.ram_disabled) {
+    if(DSP::Threaded == false) synchronize_dsp();
+    memory::apuram.write(addr, data);
+  }
 }
 
 uint8 SMP::op_debugread(uint16 addr) {
@@ -32,6 +36,7 @@ alwaysinline uint8 SMP::op_busread(uint16 addr) {
       } break;
 
       case 0xf3: {  //DSPDATA
+        if(DSP::Threaded == false && !Memory::debugger_access()) synchronize_dsp();
         //0x80-0xff are read-only mirrors of 0x00-0x7f
         r = dsp.read(status.dsp_addr & 0x7f);
         if (!Memory::debugger_access())
@@ -59,18 +64,21 @@ alwaysinline uint8 SMP::op_busread(uint16 addr) {
       } break;
 
       case 0xfd: {  //T0OUT -- 4-bit counter value
+        sync_timers();
         r = t0.stage3_ticks & 15;
         if (!Memory::debugger_access())
           t0.stage3_ticks = 0;
       } break;
 
       case 0xfe: {  //T1OUT -- 4-bit counter value
+        sync_timers();
         r = t1.stage3_ticks & 15;
         if (!Memory::debugger_access())
           t1.stage3_ticks = 0;
       } break;
 
       case 0xff: {  //T2OUT -- 4-bit counter value
+        sync_timers();
         r = t2.stage3_ticks & 15;
         if (!Memory::debugger_access())
           t2.stage3_ticks = 0;
@@ -88,6 +96,7 @@ alwaysinline void SMP::op_buswrite(uint16 addr, uint8 data) {
     switch(addr) {
       case 0xf0: {  //TEST
         if(regs.p.p) break;  //writes only valid when P flag is clear
+        sync_timers();
 
         status.internal_speed  = (data >> 6) & 3;
         status.external_speed  = (data >> 4) & 3;
@@ -102,6 +111,7 @@ alwaysinline void SMP::op_buswrite(uint16 addr, uint8 data) {
       } break;
 
       case 0xf1: {  //CONTROL
+        sync_timers();
         status.iplrom_enabled = data & 0x80;
 
         if(data & 0x30) {
@@ -142,10 +152,12 @@ alwaysinline void SMP::op_buswrite(uint16 addr, uint8 data) {
       } break;
 
       case 0xf3: {  //DSPDATA
+        if(DSP::Threaded == false) synchronize_dsp();
         //0x80-0xff are read-only mirrors of 0x00-0x7f
         if(!(status.dsp_addr & 0x80)) {
           debugger.breakpoint_test(Debugger::Breakpoint::Source::DSP, Debugger::Breakpoint::Mode::Write, status.dsp_addr & 0x7f, data);
           dsp.write(status.dsp_addr & 0x7f, data);
+          if(DSP::Threaded == false) update_echo_window();
         }
         
         if (dump_spc && status.dsp_addr == 0x4c /* r_kon */ && data) {
@@ -167,14 +179,17 @@ alwaysinline void SMP::op_buswrite(uint16 addr, uint8 data) {
       } break;
 
       case 0xfa: {  //T0TARGET
+        sync_timers();
         t0.target = data;
       } break;
 
       case 0xfb: {  //T1TARGET
+        sync_timers();
         t1.target = data;
       } break;
 
       case 0xfc: {  //T2TARGET
+        sync_timers();
         t2.target = data;
       } break;
 
@@ -1,13 +1,16 @@
 #ifdef SMP_CPP
 
 uint8 SMP::mmio_read(unsigned addr) {
-  if(!Memory::debugger_access())
+  if(!Memory::debugger_access()) {
     cpu.synchronize_smp();
+    sync.polls++;
+  }
   return port.smp_to_cpu[addr & 3];
 }
 
 void SMP::mmio_write(unsigned addr, uint8 data) {
   cpu.synchronize_smp();
+  sync.polls++;
   port.cpu_to_smp[addr & 3] = data;
 }
 
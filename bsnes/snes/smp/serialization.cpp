@@ -1,6 +1,8 @@
 #ifdef SMP_CPP
 
 void SMP::serialize(serializer &s) {
+  sync_timers();
+  if(s.mode() == serializer::Load) reset_echo_window();
   Processor::serialize(s);
   SMPcore::core_serialize(s);
 
@@ -17,6 +17,7 @@ namespace SNES {
 #include "timing/timing.cpp"
 
 void SMP::step(unsigned clocks) {
+  cycles += clocks;
   clock += clocks * (uint64)cpu.frequency;
   dsp.clock -= clocks;
 }
@@ -32,9 +33,53 @@ void SMP::synchronize_cpu() {
 void SMP::synchronize_dsp() {
   if(DSP::Threaded == true) {
     if(dsp.clock < 0) scheduler.resume(dsp.thread);
-  } else {
-    while(dsp.clock < 0) dsp.enter();
+  } else if(dsp.clock < 0) {
+    if(profiler.enabled) {
+      unsigned slot = profiler.enter(dsp);
+      while(dsp.clock < 0) dsp.enter();
+      profiler.leave(slot);
+    } else {
+      while(dsp.clock < 0) dsp.enter();
+    }
+    update_echo_window();
+  }
+}
+
+void SMP::catch_up_dsp() {
+  if(DSP::Threaded == false) synchronize_dsp();
+}
+
+void SMP::update_echo_window() {
+  uint16 base[2], pointer;
+  unsigned size = dsp.echo_window(base, pointer);
+  if(size == echo_window.size && base[0] == echo_window.base[0] && base[1] == echo_window.base[1]
+  && (pointer >> 8) == (echo_window.pointer >> 8)) return;
+
+  echo_window.base[0] = base[0];
+  echo_window.base[1] = base[1];
+  echo_window.pointer = pointer;
+  echo_window.size = size;
+  memset(echo_window.page, 0, sizeof echo_window.page);
+  if(size == 0) return;
+  for(unsigned n = 0; n < 2; n++) {
+    for(unsigned addr = base[n] & ~0xff; addr < base[n] + size; addr += 256) echo_window.page[(addr >> 8) & 255] = true;
   }
+  echo_window.page[pointer >> 8] = true;
+  echo_window.page[(pointer + 3) >> 8 & 255] = true;
+}
+
+//used whenever the S-DSP state changes other than by running: every page counts
+//as reachable until the S-DSP next catches up
+void SMP::reset_echo_window() {
+  echo_window.size = ~0;
+  memset(echo_window.page, 1, sizeof echo_window.page);
+}
+
+//called once per frame. tight port polling usually means the S-CPU is streaming
+//data into APU RAM, so keep the lock-step for the next frame while it does.
+void SMP::update_sync() {
+  sync.relaxed = config().smp.relaxed_sync && sync.polls < Sync::PollLimit;
+  sync.polls = 0;
 }
 
 void SMP::Enter() { smp.enter(); }
@@ -91,6 +136,10 @@ void SMP::reset() {
   //$00f2
   status.dsp_addr = 0x00;
 
+  sync.relaxed = config().smp.relaxed_sync;
+  sync.polls = 0;
+  reset_echo_window();
+
   //$00f4-$00f7
   for(unsigned i = 0; i < 4; i++) {
     port.cpu_to_smp[i] = 0;
@@ -125,11 +174,14 @@ void SMP::reset() {
   t0.enabled = false;
   t1.enabled = false;
   t2.enabled = false;
+
+  timer_clocks = 0;
 }
 
 SMP::SMP() {
   // put this in the ctor instead of reset so that something will still get dumped on reset if it hasn't been (?)
   dump_spc = false;
+  timer_clocks = 0;
 }
 
 SMP::~SMP() {
@@ -137,6 +189,7 @@ SMP::~SMP() {
 
 void SMP::load_dump(uint8 *dump, uint16_t pc, uint8_t r[4], uint8_t p) {
   memcpy(memory::apuram.data(), dump, memory::apuram.size());
+  memory::apuram.mark_all();
 
   // set up some status from RAM values
   op_buswrite(0xFC, dump[0xFC]);
@@ -166,6 +219,7 @@ void SMP::load_dump(uint8 *dump, uint16_t pc, uint8_t r[4], uint8_t p) {
   
   // read DSP registers
   dsp.load(dump + memory::apuram.size());
+  reset_echo_window();
 }
 
 void SMP::save_spc_dump(string path) {
@@ -178,6 +232,8 @@ void SMP::save_spc_dump(string path) {
 
 void SMP::save_spc_dump() {
   dump_spc = false;
+  sync_timers();
+  catch_up_dsp();
     
   file out;
   if (!out.open(spc_path(), file::mode::write)) {
@@ -19,6 +19,23 @@ public:
 
   static const uint8 iplrom[64];
 
+  //relaxed synchronization (config().smp.relaxed_sync):
+  //the per-opcode debugger lock-step between the S-CPU and the S-SMP is skipped.
+  //the S-CPU <> S-SMP ports are still synchronized exactly on every access.
+  struct Sync {
+    enum : unsigned { PollLimit = 512 };
+    bool relaxed;     //lock-step skipped for the current frame
+    unsigned polls;   //S-CPU accesses to $2140-$217f during the current frame
+  } sync;
+  void update_sync();
+
+  //non-threaded S-DSP (DSP::Threaded == false): the S-DSP runs behind the S-SMP in
+  //blocks of up to DSPBlock clocks, and catches up before the S-SMP accesses its
+  //registers, writes to APU RAM or reads APU RAM that a pending echo write may reach.
+  //this is exact: the S-DSP output and the emulated state do not change.
+  enum : unsigned { DSPBlock = 32 * 768 };
+  void catch_up_dsp();  //before savestates
+
 private:
   #include "memory/memory.hpp"
   #include "mmio/mmio.hpp"
@@ -49,6 +66,16 @@ private:
     uint8 aux[2];
   } port;
 
+  //APU RAM pages that S-DSP echo writes may reach before the next catch-up
+  struct EchoWindow {
+    uint16 base[2];
+    uint16 pointer;
+    unsigned size;
+    bool page[256];
+  } echo_window;
+  void update_echo_window();
+  void reset_echo_window();
+
   static void Enter();
   debugvirtual void op_step();
   
@@ -24,7 +24,11 @@ void SMP::wait(uint16 addr, bool half) {
 
 void SMP::add_clocks(unsigned clocks) {
   step(clocks);
-  synchronize_dsp();
+  if(DSP::Threaded == false) {
+    if(dsp.clock < -(int64)DSPBlock) synchronize_dsp();
+  } else {
+    synchronize_dsp();
+  }
 
   //forcefully sync S-SMP to S-CPU in case chips are not communicating
   //sync if S-SMP is more than 24 samples ahead of S-CPU
@@ -32,21 +36,51 @@ void SMP::add_clocks(unsigned clocks) {
 }
 
 void SMP::step_timers(unsigned clocks) {
-  t0.step(clocks);
-  t1.step(clocks);
-  t2.step(clocks);
+  timer_clocks += clocks;
+  if(timer_clocks >= 1 << 24) sync_timers();  //keep the sums in range
+}
+
+//called before $00f0, $00f1, $00fa-$00ff are accessed, and before the timers are
+//saved or displayed. the enable, disable and target settings cannot change between
+//two calls, which lets each timer take all pending clocks in a single step.
+void SMP::sync_timers() {
+  if(timer_clocks == 0) return;
+  t0.step(timer_clocks);
+  t1.step(timer_clocks);
+  t2.step(timer_clocks);
+  timer_clocks = 0;
 }
 
 template<unsigned timer_frequency>
 void SMP::sSMPTimer<timer_frequency>::step(unsigned clocks) {
   //stage 0 increment
-  stage0_ticks += clocks;
-  if(stage0_ticks < timer_frequency) return;
-  stage0_ticks -= timer_frequency;
+  unsigned ticks = stage0_ticks + clocks;
+  stage0_ticks = ticks % timer_frequency;
+  unsigned toggles = ticks / timer_frequency;
+  if(toggles == 0) return;
 
   //stage 1 increment
   stage1_ticks ^= 1;
   sync_stage1();
+  if(--toggles == 0) return;
+
+  //from here on the line follows stage 1, and every other toggle is a 1->0 pulse
+  bool line = smp.status.timers_enabled && !smp.status.timers_disabled;
+  unsigned pulses = line ? (toggles + stage1_ticks) >> 1 : 0;
+  stage1_ticks ^= toggles & 1;
+  current_line = line && stage1_ticks;
+
+  //stage 2 increment, stage 3 increment on every match of the target
+  if(enabled == false || pulses == 0) return;
+  unsigned period = target ? target : 256;
+  unsigned first = ((target - stage2_ticks - 1) & 255) + 1;
+  if(pulses < first) {
+    stage2_ticks += pulses;
+    return;
+  }
+  pulses -= first;
+  stage2_ticks = pulses % period;
+  stage3_ticks = (stage3_ticks + 1 + pulses / period) & 15;
 }
 
 template<unsigned frequency>
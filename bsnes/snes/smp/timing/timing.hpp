@@ -17,6 +17,11 @@ sSMPTimer<128> t0;
 sSMPTimer<128> t1;
 sSMPTimer< 16> t2;
 
+//timer clocks not yet applied to t0-t2: the timers are only brought up to date
+//before their state is observed or changed (see sync_timers)
+unsigned timer_clocks;
+
 alwaysinline void wait(uint16 addr, bool half = false);
 alwaysinline void add_clocks(unsigned clocks);
 alwaysinline void step_timers(unsigned clocks);
+void sync_timers();
@@ -6,7 +6,8 @@ namespace SNES {
     #endif
     static const char Version[] = BSNES_VERSION;
     static const unsigned SerializerSignature = 0x43545342; //'BSTC'
-    static const unsigned SerializerVersion = 15;
+    static const unsigned SerializerDeltaSignature = 0x44545342; //'BSTD'
+    static const unsigned SerializerVersion = 18;
   }
 }
 
@@ -96,12 +97,14 @@ namespace SNES {
     cothread_t thread;
     unsigned frequency;
     int64 clock;
+    uint64 cycles;  //clocks executed since create(); statistics only, not serialized
 
     inline void create(void (*entrypoint_)(), unsigned frequency_) {
       if(thread) co_delete(thread);
       thread = co_create(65536 * sizeof(void*), entrypoint_);
       frequency = frequency_;
       clock = 0;
+      cycles = 0;
     }
 
     inline void serialize(serializer &s) {
@@ -113,7 +116,7 @@ namespace SNES {
       return co_active() == thread;
     }
 
-    inline Processor() : thread(0) {}
+    inline Processor() : thread(0), cycles(0) {}
   };
 
   struct ChipDebugger {
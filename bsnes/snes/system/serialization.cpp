@@ -2,8 +2,58 @@
 
 serializer System::serialize() {
   serializer s(serialize_size);
+  serialize_state(s);
+  return s;
+}
 
-  unsigned signature = Info::SerializerSignature, version = Info::SerializerVersion, crc32 = cartridge.crc32();
+bool System::serialize(uint8 *data, unsigned size) {
+  if(size < serialize_size) return false;
+  serializer s(serializer::Save, data, serialize_size);
+  serialize_state(s);
+  return true;
+}
+
+bool System::unserialize(const uint8 *data, unsigned size) {
+  //Load mode never writes to the buffer
+  serializer s(serializer::Load, (uint8*)data, size);
+  return unserialize(s);
+}
+
+bool System::unserialize(serializer &s) {
+  unsigned signature, version, crc32, epoch;
+  char profile[16], description[512];
+
+  if(s.capacity() != serialize_size) return false;
+
+  s.integer(signature);
+  s.integer(version);
+  s.integer(crc32);
+  s.array(profile);
+  s.array(description);
+  s.integer(epoch);
+
+  if(signature != Info::SerializerSignature) return false;
+  if(version != Info::SerializerVersion) return false;
+//if(crc32 != cartridge.crc32()) return false;
+  if(strcmp(profile, Info::Profile)) return false;
+
+  //continue the epochs of the loaded state, so that deltas taken relative to it apply
+  DirtyPages::epoch = epoch;
+  reset();
+  serialize_all(s);
+  DirtyPages::epoch++;
+  return true;
+}
+
+unsigned System::epoch() const {
+  return DirtyPages::epoch;
+}
+
+serializer System::serialize_delta(unsigned since) {
+  serializer s(serialize_delta_size);
+
+  unsigned signature = Info::SerializerDeltaSignature, version = Info::SerializerVersion, crc32 = cartridge.crc32();
+  unsigned epoch = DirtyPages::epoch, length = 0;
   char profile[16], description[512];
   memset(&profile, 0, sizeof profile);
   memset(&description, 0, sizeof description);
@@ -14,68 +64,145 @@ serializer System::serialize() {
   s.integer(crc32);
   s.array(profile);
   s.array(description);
-
+  s.integer(since);
+  s.integer(epoch);
+  unsigned offset = s.size();
+  s.integer(length);
+
+  smp.catch_up_dsp();
+  DirtyPages::delta = true;
+  DirtyPages::since = since;
   serialize_all(s);
+  DirtyPages::delta = false;
+  DirtyPages::epoch++;
+
+  //the number of bytes used, for unserialize_delta() to check the buffer against
+  length = s.size();
+  serializer patch(serializer::Save, (uint8*)s.data() + offset, sizeof length);
+  patch.integer(length);
   return s;
 }
 
-bool System::unserialize(serializer &s) {
-  unsigned signature, version, crc32;
+bool System::unserialize_delta(serializer &s) {
+  unsigned signature, version, crc32, since, epoch, length;
   char profile[16], description[512];
 
-  if(s.capacity() != serialize_size) return false;
+  if(s.capacity() < delta_header_size || s.capacity() > serialize_delta_size) return false;
 
   s.integer(signature);
   s.integer(version);
   s.integer(crc32);
   s.array(profile);
   s.array(description);
+  s.integer(since);
+  s.integer(epoch);
+  s.integer(length);
 
-  if(signature != Info::SerializerSignature) return false;
+  if(signature != Info::SerializerDeltaSignature) return false;
   if(version != Info::SerializerVersion) return false;
-//if(crc32 != cartridge.crc32()) return false;
+  if(crc32 != cartridge.crc32()) return false;
   if(strcmp(profile, Info::Profile)) return false;
-
+  //pages written before `since` are not in the delta: the current state must be the one
+  //saved or loaded at that epoch
+  if(since != DirtyPages::epoch) return false;
+  if(length < delta_header_size || length > s.capacity()) return false;
+
+  //the page masks decide how much is read. a delta never exceeds serialize_delta_size,
+  //so reading from a buffer of that size stays in bounds even if the masks are damaged
+  unsigned size = serialize_delta_size - delta_header_size;
+  uint8 *data = new uint8[size]();
+  memcpy(data, s.data() + delta_header_size, length - delta_header_size);
+  serializer body(serializer::Load, data, size);
+
+  //reset() clears APU RAM and SA-1 I-RAM; keep the pages this delta does not carry
+  uint8 *apuram = new uint8[memory::apuram.size()];
+  uint8 *iram = new uint8[memory::iram.size()];
+  memcpy(apuram, memory::apuram.data(), memory::apuram.size());
+  memcpy(iram, memory::iram.data(), memory::iram.size());
   reset();
-  serialize_all(s);
-  return true;
+  memcpy(memory::apuram.data(), apuram, memory::apuram.size());
+  memcpy(memory::iram.data(), iram, memory::iram.size());
+  delete[] apuram;
+  delete[] iram;
+
+  DirtyPages::epoch = epoch;
+  DirtyPages::delta = true;
+  serialize_all(body);
+  DirtyPages::delta = false;
+  DirtyPages::epoch++;
+  bool consumed = (body.size() == length - delta_header_size);
+  delete[] data;
+  return consumed;
 }
 
 //========
 //internal
 //========
 
+void System::serialize_state(serializer &s) {
+  unsigned signature = Info::SerializerSignature, version = Info::SerializerVersion, crc32 = cartridge.crc32();
+  char profile[16], description[512];
+  memset(&profile, 0, sizeof profile);
+  memset(&description, 0, sizeof description);
+  strlcpy(profile, Info::Profile, sizeof profile);
+
+  s.integer(signature);
+  s.integer(version);
+  s.integer(crc32);
+  s.array(profile);
+  s.array(description);
+  s.integer(DirtyPages::epoch);
+
+  smp.catch_up_dsp();
+  serialize_all(s);
+  DirtyPages::epoch++;
+}
+
 void System::serialize(serializer &s) {
   s.integer((unsigned&)region);
   s.integer((unsigned&)expansion);
 }
 
+//starts a new StateRegion at the current offset during serialize_init()
+void System::serialize_region(serializer &s, const char *name) {
+  if(state_recording == false || state_regions >= StateRegions) return;
+  if(state_regions) {
+    StateRegion &last = state_region[state_regions - 1];
+    last.size = s.size() - last.offset;
+  }
+  state_region[state_regions].name = name;
+  state_region[state_regions].offset = s.size();
+  state_region[state_regions].size = 0;
+  state_regions++;
+}
+
 void System::serialize_all(serializer &s) {
   bus.serialize(s);
-  cartridge.serialize(s);
-  system.serialize(s);
-  random.serialize(s);
-  cpu.serialize(s);
-  smp.serialize(s);
-  ppu.serialize(s);
-  dsp.serialize(s);
+  serialize_region(s, "cartridge"); cartridge.serialize(s);
+  serialize_region(s, "system"); system.serialize(s);
+  serialize_region(s, "random"); random.serialize(s);
+  serialize_region(s, "cpu"); cpu.serialize(s);
+  serialize_region(s, "smp"); smp.serialize(s);
+  serialize_region(s, "ppu"); ppu.serialize(s);
+  serialize_region(s, "dsp"); dsp.serialize(s);
 
   // always include expansion port device(s) in savestate size
-  bsxbase.serialize(s);
+  serialize_region(s, "bsxbase"); bsxbase.serialize(s);
   
-  if(cartridge.bsxpack_type() == Cartridge::BSXPackType::FlashROM) bsxflash.serialize(s);
-  if(cartridge.mode() == Cartridge::Mode::Bsx) bsxcart.serialize(s);
-  if(cartridge.mode() == Cartridge::Mode::SuperGameBoy) supergameboy.serialize(s);
-  if(cartridge.has_superfx()) superfx.serialize(s);
-  if(cartridge.has_sa1()) sa1.serialize(s);
-  if(cartridge.has_necdsp()) necdsp.serialize(s);
-  if(cartridge.has_srtc()) srtc.serialize(s);
-  if(cartridge.has_sdd1()) sdd1.serialize(s);
-  if(cartridge.has_spc7110()) spc7110.serialize(s);
-  if(cartridge.has_cx4()) cx4.serialize(s);
-  if(cartridge.has_obc1()) obc1.serialize(s);
-  if(cartridge.has_msu1()) msu1.serialize(s);
-  if(cartridge.has_serial()) serial.serialize(s);
+  if(cartridge.bsxpack_type() == Cartridge::BSXPackType::FlashROM) { serialize_region(s, "bsxflash"); bsxflash.serialize(s); }
+  if(cartridge.mode() == Cartridge::Mode::Bsx) { serialize_region(s, "bsxcart"); bsxcart.serialize(s); }
+  if(cartridge.mode() == Cartridge::Mode::SuperGameBoy) { serialize_region(s, "supergameboy"); supergameboy.serialize(s); }
+  if(cartridge.has_superfx()) { serialize_region(s, "superfx"); superfx.serialize(s); }
+  if(cartridge.has_sa1()) { serialize_region(s, "sa1"); sa1.serialize(s); }
+  if(cartridge.has_necdsp()) { serialize_region(s, "necdsp"); necdsp.serialize(s); }
+  if(cartridge.has_dsp1()) { serialize_region(s, "dsp1"); dsp1.serialize(s); }
+  if(cartridge.has_srtc()) { serialize_region(s, "srtc"); srtc.serialize(s); }
+  if(cartridge.has_sdd1()) { serialize_region(s, "sdd1"); sdd1.serialize(s); }
+  if(cartridge.has_spc7110()) { serialize_region(s, "spc7110"); spc7110.serialize(s); }
+  if(cartridge.has_cx4()) { serialize_region(s, "cx4"); cx4.serialize(s); }
+  if(cartridge.has_obc1()) { serialize_region(s, "obc1"); obc1.serialize(s); }
+  if(cartridge.has_msu1()) { serialize_region(s, "msu1"); msu1.serialize(s); }
+  if(cartridge.has_serial()) { serialize_region(s, "serial"); serial.serialize(s); }
 }
 
 //called once upon cartridge load event: perform dry-run state save.
@@ -84,17 +211,41 @@ void System::serialize_all(serializer &s) {
 void System::serialize_init() {
   serializer s;
 
-  unsigned signature = 0, version = 0, crc32 = 0;
+  unsigned signature = 0, version = 0, crc32 = 0, epoch = 0, since = 0, length = 0;
   char profile[16], description[512];
 
+  state_regions = 0;
+  state_recording = true;
+  serialize_region(s, "header");
   s.integer(signature);
   s.integer(version);
   s.integer(crc32);
   s.array(profile);
   s.array(description);
+  s.integer(epoch);
 
   serialize_all(s);
+  StateRegion &last = state_region[state_regions - 1];
+  last.size = s.size() - last.offset;
+  state_recording = false;
   serialize_size = s.size();
+
+  //delta savestates: header plus epochs and length, and room for every RAM page
+  serializer delta;
+  delta.integer(signature);
+  delta.integer(version);
+  delta.integer(crc32);
+  delta.array(profile);
+  delta.array(description);
+  delta.integer(since);
+  delta.integer(epoch);
+  delta.integer(length);
+  delta_header_size = delta.size();
+
+  DirtyPages::delta = true;
+  serialize_all(delta);
+  DirtyPages::delta = false;
+  serialize_delta_size = delta.size();
 }
 
 #endif
@@ -1,4 +1,8 @@
 #include <snes.hpp>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
 
 #define SYSTEM_CPP
 namespace SNES {
@@ -8,6 +12,7 @@ System system;
 #include <config/config.cpp>
 #include <debugger/debugger.cpp>
 #include <scheduler/scheduler.cpp>
+#include <scheduler/profiler.cpp>
 
 #include <video/video.cpp>
 #include <audio/audio.cpp>
@@ -23,51 +28,52 @@ void System::run() {
   if(scheduler.exit_reason() == Scheduler::ExitReason::FrameEvent) {
     input.update();
     video.update();
+    if(profiler.enabled) profiler.frame_event();
   }
 }
 
+void System::set_render_video(bool enable) {
+  render_video = enable;
+}
+
 void System::runtosave() {
+  auto start = std::chrono::steady_clock::now();
   scheduler.mode = Scheduler::Mode::Synchronize;
- 
-  //run every thread until it cleanly hits a synchronization point
-  //if it fails, start resynchronizing every thread again
-  while (true) {
-    if(SMP::Threaded == true) {
-      if (!runthreadtosave(smp.thread)) continue;
-    }
-    if(CPU::Threaded == true) {
-      if (!runthreadtosave(cpu.thread)) continue;
-    }
-    if(PPU::Threaded == true) {
-      if (!runthreadtosave(ppu.thread)) continue;
-    }
-    if(DSP::Threaded == true) {
-      if (!runthreadtosave(dsp.thread)) continue;
-    }
-	bool synchronized = true;
-    for(unsigned i = 0; i < cpu.coprocessors.size(); i++) {
-      Processor &chip = *cpu.coprocessors[i];
-      synchronized &= runthreadtosave(chip.thread);
-    }
-	if (synchronized) break;
+
+  //run every thread until it cleanly hits a synchronization point.
+  //a thread that switches to another one is left mid-instruction and has to
+  //be entered again, but threads that already synchronized stay put: each
+  //entry only runs up to the next instruction boundary of the threads involved
+  scheduler.unsynchronized_count = 0;
+  if(SMP::Threaded == true) scheduler.desynchronize(smp.thread);
+  if(CPU::Threaded == true) scheduler.desynchronize(cpu.thread);
+  if(PPU::Threaded == true) scheduler.desynchronize(ppu.thread);
+  if(DSP::Threaded == true) scheduler.desynchronize(dsp.thread);
+  for(unsigned i = 0; i < cpu.coprocessors.size(); i++) {
+    scheduler.desynchronize(cpu.coprocessors[i]->thread);
   }
-  
-  scheduler.mode = Scheduler::Mode::Run;
-  scheduler.thread = cpu.thread;
-}
 
-bool System::runthreadtosave(cothread_t& thread) {
-  scheduler.thread = thread;
-  while(true) {
+  unsigned entries = 0;
+  while(scheduler.unsynchronized_count) {
+    scheduler.thread = scheduler.unsynchronized[0];
     scheduler.enter();
-    if(scheduler.exit_reason() == Scheduler::ExitReason::SynchronizeEvent) break;
-    if(scheduler.exit_reason() == Scheduler::ExitReason::DesynchronizeEvent) return false;
+    entries++;
     if(scheduler.exit_reason() == Scheduler::ExitReason::FrameEvent) {
       input.update();
       video.update();
+      if(profiler.enabled) profiler.frame_event();
     }
   }
-  return true;
+
+  scheduler.mode = Scheduler::Mode::Run;
+  scheduler.thread = cpu.thread;
+
+  uint64 time = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+  save_latency.count++;
+  save_latency.time = time;
+  save_latency.entries = entries;
+  save_latency.max_time = max(save_latency.max_time, time);
+  save_latency.max_entries = max(save_latency.max_entries, entries);
 }
 
 void System::init(Interface *interface_) {
@@ -78,6 +84,7 @@ void System::init(Interface *interface_) {
   superfx.init();
   sa1.init();
   necdsp.init();
+  dsp1.init();
   bsxbase.init();
   bsxcart.init();
   bsxflash.init();
@@ -99,6 +106,7 @@ void System::init(Interface *interface_) {
 }
 
 void System::term() {
+  video.set_present_thread(false);
 }
 
 void System::power() {
@@ -130,6 +138,7 @@ void System::power() {
   if(cartridge.has_superfx()) superfx.enable();
   if(cartridge.has_sa1()) sa1.enable();
   if(cartridge.has_necdsp()) necdsp.enable();
+  if(cartridge.has_dsp1()) dsp1.enable();
   if(cartridge.has_srtc()) srtc.enable();
   if(cartridge.has_sdd1()) sdd1.enable();
   if(cartridge.has_spc7110()) spc7110.enable();
@@ -154,6 +163,7 @@ void System::power() {
   if(cartridge.has_superfx()) superfx.power();
   if(cartridge.has_sa1()) sa1.power();
   if(cartridge.has_necdsp()) necdsp.power();
+  if(cartridge.has_dsp1()) dsp1.power();
   if(cartridge.has_srtc()) srtc.power();
   if(cartridge.has_sdd1()) sdd1.power();
   if(cartridge.has_spc7110()) spc7110.power();
@@ -200,6 +210,7 @@ void System::reset() {
   if(cartridge.has_superfx()) superfx.reset();
   if(cartridge.has_sa1()) sa1.reset();
   if(cartridge.has_necdsp()) necdsp.reset();
+  if(cartridge.has_dsp1()) dsp1.reset();
   if(cartridge.has_srtc()) srtc.reset();
   if(cartridge.has_sdd1()) sdd1.reset();
   if(cartridge.has_spc7110()) spc7110.reset();
@@ -230,6 +241,7 @@ void System::reset() {
 }
 
 void System::unload() {
+  video.present_join();
   bsxbase.unload();
   if(cartridge.mode() == Cartridge::Mode::SuperGameBoy) supergameboy.unload();
   
@@ -243,7 +255,10 @@ void System::unload() {
 
 void System::scanline() {
   video.scanline();
-  if(cpu.vcounter() == 241) scheduler.exit(Scheduler::ExitReason::FrameEvent);
+  if(cpu.vcounter() == 241) {
+    smp.update_sync();
+    scheduler.exit(Scheduler::ExitReason::FrameEvent);
+  }
 }
 
 void System::frame() {
@@ -251,9 +266,12 @@ void System::frame() {
 
 bool System::has_power() const { return powered; }
 
-System::System() : interface(0), powered(false) {
+System::System() : interface(0), powered(false), serialize_delta_size(0), delta_header_size(0), state_recording(false) {
+  state_regions = 0;
   region = Region::Autodetect;
   expansion = ExpansionPortDevice::None;
+  render_video = true;
+  memset(&save_latency, 0, sizeof save_latency);
 }
 
 }
@@ -8,6 +8,19 @@ public:
   void run();
   void runtosave();
 
+  //when disabled, the PPU keeps exact timing and state (savestates stay
+  //identical to a rendered run) but composes no pixels, and the interface
+  //receives no video_refresh. meant for replaying movies to a target frame.
+  readonly<bool> render_video;
+  void set_render_video(bool);
+
+  //cost of runtosave(): host time (in nanoseconds) and scheduler entries
+  struct SaveLatency {
+    unsigned count;
+    uint64 time, max_time;
+    unsigned entries, max_entries;
+  } save_latency;
+
   void init(Interface*);
   void term();
   void power();
@@ -29,21 +42,50 @@ public:
   serializer serialize();
   bool unserialize(serializer&);
 
+  //in-place savestates: no intermediate buffer is allocated or copied.
+  //the buffer must hold at least serialize_size bytes.
+  bool serialize(uint8 *data, unsigned size);
+  bool unserialize(const uint8 *data, unsigned size);
+
+  //byte range of each component within a full savestate, recorded when a
+  //cartridge is loaded, for callers that compare or patch states themselves
+  struct StateRegion {
+    const char *name;
+    unsigned offset, size;
+  };
+  enum : unsigned { StateRegions = 32 };
+  StateRegion state_region[StateRegions];
+  unsigned state_regions;
+
+  //incremental savestates: RAM pages not written since epoch `since` are omitted.
+  //pass the epoch() read right after saving or loading the base state. a delta is
+  //only applied while the current state is that base: unserialize_delta() rejects
+  //it after any other state was saved or loaded, and before changing anything.
+  unsigned epoch() const;
+  serializer serialize_delta(unsigned since);
+  bool unserialize_delta(serializer&);
+
   System();
 
 private:
   bool powered;
+  unsigned serialize_delta_size;
+  unsigned delta_header_size;
   Interface *interface;
-  bool runthreadtosave(cothread_t&);
+  bool state_recording;
 
   void serialize(serializer&);
+  void serialize_state(serializer&);
+  void serialize_region(serializer&, const char *name);
   void serialize_all(serializer&);
   void serialize_init();
 
+  friend struct Bus;
   friend class Cartridge;
   friend class Video;
   friend class Audio;
   friend class Input;
+  friend class DSP1;
 };
 
 struct Random {
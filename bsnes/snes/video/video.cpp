@@ -47,6 +47,14 @@ void Video::draw_cursor(uint16_t color, int x, int y) {
 }
 
 void Video::update() {
+  ppu.render_join();
+
+  if(!system.render_video()) {
+    frame_hires = false;
+    frame_interlace = false;
+    return;
+  }
+
   switch(input.port[1].device) {
     case Input::Device::SuperScope: draw_cursor(0x001f, input.port[1].superscope.x, input.port[1].superscope.y); break;
     case Input::Device::Justifiers: draw_cursor(0x02e0, input.port[1].justifier.x2, input.port[1].justifier.y2); //fallthrough
@@ -72,13 +80,16 @@ void Video::update() {
     }
   }
 
+  if(ppu.frame_skipped()) skipped_frames++;
+  system.interface->video_frameskip(skipped_frames);
   system.interface->video_extras(data, width, height);
 
   if(frame_interlace) {
     height <<= 1;
   }
 
-  system.interface->video_refresh(ppu.output + 1024, width, height);
+  if(present) present_frame(ppu.output + 1024, width, height);
+  else system.interface->video_refresh(ppu.output + 1024, width, height);
 
   frame_hires = false;
   frame_interlace = false;
@@ -97,7 +108,101 @@ void Video::scanline() {
 void Video::init() {
   frame_hires = false;
   frame_interlace = false;
+  skipped_frames = 0;
   for(unsigned i = 0; i < 240; i++) line_width[i] = 256;
 }
 
+//frames are copied rather than presented from the PPU surface: the PPU starts drawing the
+//next frame into it right away, and interlaced frames keep the other field there.
+//the copy spans the same window of the surface that interfaces may read when given it
+//directly: PAL displays start 7 lines above the frame unless it is overscanned, and
+//overscanned frames are 239 lines tall
+struct Video::PresentThread {
+  enum : unsigned { LeadIn = 7, Lines = 239 };
+  struct Frame {
+    uint16_t data[1024 * (LeadIn + Lines)];
+    unsigned width, height;
+  } frames[PresentSlots];
+  unsigned head, tail;  //frames queued and presented
+
+  std::mutex mutex;
+  std::condition_variable wake, idle;
+  bool stop;
+  std::thread thread;
+
+  void run() {
+    std::unique_lock<std::mutex> lock(mutex);
+    while(true) {
+      wake.wait(lock, [&] { return stop || tail != head; });
+      if(tail == head) return;
+
+      const Frame &frame = frames[tail % PresentSlots];
+      lock.unlock();
+      system.interface->video_refresh(frame.data + LeadIn * 1024, frame.width, frame.height);
+      lock.lock();
+      tail++;
+      idle.notify_all();
+    }
+  }
+
+  PresentThread() : head(0), tail(0), stop(false) {
+    thread = std::thread([this] { run(); });
+  }
+
+  ~PresentThread() {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      stop = true;
+    }
+    wake.notify_all();
+    thread.join();
+  }
+};
+
+void Video::set_present_thread(bool enable) {
+  if(enable == (bool)present) return;
+  if(enable) {
+    present = new PresentThread;
+  } else {
+    delete present;
+    present = 0;
+  }
+}
+
+void Video::present_join() {
+  if(!present) return;
+  std::unique_lock<std::mutex> lock(present->mutex);
+  present->idle.wait(lock, [&] { return present->tail == present->head; });
+}
+
+void Video::present_frame(const uint16_t *data, unsigned width, unsigned height) {
+  PresentThread &t = *present;
+  std::unique_lock<std::mutex> lock(t.mutex);
+  t.idle.wait(lock, [&] { return t.head - t.tail < PresentSlots; });
+  PresentThread::Frame &frame = t.frames[t.head % PresentSlots];
+  lock.unlock();
+
+  //interlaced frames interleave both fields: rows are half as far apart
+  unsigned pitch = height >= 240 ? 512 : 1024;
+  unsigned rows = (PresentThread::LeadIn + PresentThread::Lines) * 1024 / pitch;
+  const uint16_t *source = data - PresentThread::LeadIn * 1024;
+  for(unsigned y = 0; y < rows; y++) {
+    memcpy(frame.data + y * pitch, source + y * pitch, width * sizeof(uint16_t));
+  }
+  frame.width = width;
+  frame.height = height;
+
+  lock.lock();
+  t.head++;
+  t.wake.notify_one();
+}
+
+Video::Video() {
+  present = 0;
+}
+
+Video::~Video() {
+  set_present_thread(false);
+}
+
 #endif
@@ -1,8 +1,24 @@
 class Video {
+public:
+  //with a presentation thread, Video::update() hands a copy of each frame to a second
+  //thread, which calls Interface::video_refresh() while emulation continues. up to
+  //PresentSlots frames may be waiting; present_join() waits until all were presented.
+  enum : unsigned { PresentSlots = 3 };
+  void set_present_thread(bool enable);
+  bool get_present_thread() const { return present; }
+  void present_join();
+
+  Video();
+  ~Video();
+
 private:
+  struct PresentThread;
+  PresentThread *present;
+
   bool frame_hires;
   bool frame_interlace;
   unsigned line_width[240];
+  unsigned skipped_frames;
 
   void update();
   void scanline();
@@ -10,6 +26,7 @@ private:
 
   static const uint8_t cursor[15 * 15];
   void draw_cursor(uint16_t color, int x, int y);
+  void present_frame(const uint16_t *data, unsigned width, unsigned height);
 
   friend class System;
 };
@@ -160,6 +160,7 @@ int Application::main(int &argc, char **argv) {
   mapper().bind();
   init();
   SNES::system.init(&interface);
+  SNES::video.set_present_thread(config().video.presentThread);
   mainWindow->system_loadSpecial_superGameBoy->setVisible(SNES::supergameboy.opened());
 
   parseArguments();
@@ -224,6 +225,7 @@ void Application::run() {
       frameAdvance = false;
     }
   }
+  interface.present();
 
   clock_t currentTime = clock();
   autosaveTime += currentTime - clockTime;
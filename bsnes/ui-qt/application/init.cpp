@@ -83,6 +83,7 @@ void Application::init() {
   audio.set(Audio::Frequency, config().audio.outputFrequency);
   audio.set(Audio::Latency, config().audio.latency);
   audio.set(Audio::Volume, config().audio.volume);
+  audio.set(Audio::OutputThread, config().audio.outputThread);
   if(audio.init() == false) {
     QMessageBox::warning(0, "bsnes", string() <<
       "<p><b>Warning:</b> " << config().system.audio << " audio driver failed to initialize. "
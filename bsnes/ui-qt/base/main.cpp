@@ -620,6 +620,7 @@ void MainWindow::recordMovieFromHere() {
 
 void MainWindow::saveScreenshot() {
   //tell SNES::Interface to save a screenshot at the next video_refresh() event
+  SNES::video.present_join();
   interface.saveScreenshot = true;
 }
 
@@ -28,9 +28,14 @@ Configuration::Configuration() {
 
   attach(snes_config.smp.ntsc_frequency = 24607104, "smp.ntscFrequency");
   attach(snes_config.smp.pal_frequency  = 24607104, "smp.palFrequency");
+  attach(snes_config.smp.relaxed_sync = false, "smp.relaxedSync", "Skip the S-CPU/S-SMP lock-step between APU port accesses (faster)");
+
+  attach(snes_config.coprocessor.sync_window = 0, "coprocessor.syncWindow", "Clocks the NEC DSP and Cx4 may run ahead of the S-CPU between accesses; 0 = lock-step (takes effect on reset)");
+  attach(snes_config.coprocessor.dsp1 = "lle", "coprocessor.dsp1", "DSP-1 emulation: lle = run the firmware, hle = built-in command set (no coprocessor thread), verify = run both and report the first difference (takes effect on cartridge load)");
 
   attach(snes_config.ppu1.version = 1, "ppu1.version", "Valid version(s) are: 1");
   attach(snes_config.ppu2.version = 3, "ppu2.version", "Valid version(s) are: 1, 2, 3");
+  attach(snes_config.ppu2.render_thread = false, "ppu2.renderThread", "Draw scanlines on a second thread (compatibility and performance profiles; takes effect on power cycle)");
 
   attach(snes_config.path.firmware = "", "path.firmware");
 
@@ -55,6 +60,8 @@ Configuration::Configuration() {
   attach(system.speedFastest = 200, "system.speedFastest");
   attach(system.autoSaveMemory = false, "system.autoSaveMemory", "Automatically save cartridge back-up RAM once every minute");
   attach(system.rewindEnabled  = false, "system.rewindEnabled", "Automatically save states periodically to allow auto-rewind support");
+  attach(system.rewindInterval = 1, "system.rewindInterval", "Number of frames between rewind snapshots");
+  attach(system.rewindMemory   = 32, "system.rewindMemory", "Memory reserved for rewind snapshots, in megabytes");
 
   attach(diskBrowser.useCommonDialogs = false, "diskBrowser.useCommonDialogs");
   attach(diskBrowser.showPanel = true, "diskBrowser.showPanel");
@@ -102,6 +109,7 @@ Configuration::Configuration() {
   attach(video.cropBottom = 0, "video.cropBottom");
 
   attach(video.unfilteredScreenshot = true, "video.unfilteredScreenshot");
+  attach(video.presentThread = false, "video.presentThread", "Filter each frame on a separate thread while the next one is emulated (takes effect on restart)");
 
   attach(video.windowed.correctAspectRatio = true, "video.windowed.correctAspectRatio");
   attach(video.windowed.multiplier         =    2, "video.windowed.multiplier");
@@ -119,6 +127,7 @@ Configuration::Configuration() {
 
   attach(audio.synchronize = true,  "audio.synchronize");
   attach(audio.mute        = false, "audio.mute");
+  attach(audio.outputThread = false, "audio.outputThread", "Feed the audio driver from a separate thread, so that waiting on the device happens off the emulation thread");
 
   attach(audio.volume          =   100, "audio.volume");
   attach(audio.latency         =    80, "audio.latency");
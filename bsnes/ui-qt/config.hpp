@@ -12,6 +12,8 @@ public:
     unsigned speedFastest;
     bool autoSaveMemory;
     bool rewindEnabled;
+    unsigned rewindInterval;
+    unsigned rewindMemory;
   } system;
 
   struct File {
@@ -54,6 +56,7 @@ public:
     unsigned cropBottom;
 
     bool unfilteredScreenshot;
+    bool presentThread;
 
     struct Context {
       bool correctAspectRatio;
@@ -65,6 +68,7 @@ public:
   struct Audio {
     bool synchronize;
     bool mute;
+    bool outputThread;
     unsigned volume, latency, outputFrequency, inputFrequency;
   } audio;
 
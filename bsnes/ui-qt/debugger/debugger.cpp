@@ -85,6 +85,11 @@ Debugger::Debugger() {
   menu_misc_showHClocks = menu_misc->addAction("Show &H-position in clocks instead of dots");
   menu_misc_showHClocks->setCheckable(true);
   menu_misc_showHClocks->setChecked(config().debugger.showHClocks);
+  menu_misc->addSeparator();
+  menu_misc_profiler = menu_misc->addAction("Enable scheduler &profiler");
+  menu_misc_profiler->setCheckable(true);
+  menu_misc_profiler->setChecked(SNES::profiler.enabled);
+  menu_misc_profileReport = menu_misc->addAction("Print scheduler profile to &console");
 
   tracer = new Tracer;
   breakpointEditor = new BreakpointEditor;
@@ -226,6 +231,8 @@ Debugger::Debugger() {
   connect(menu_misc_loadDefaultSymbols, SIGNAL(triggered()), this, SLOT(synchronize()));
   connect(menu_misc_saveSymbols, SIGNAL(triggered()), this, SLOT(synchronize()));
   connect(menu_misc_showHClocks, SIGNAL(triggered()), this, SLOT(synchronize()));
+  connect(menu_misc_profiler, SIGNAL(triggered()), this, SLOT(synchronize()));
+  connect(menu_misc_profileReport, SIGNAL(triggered()), this, SLOT(printProfile()));
 
   connect(runBreak->defaultAction(), SIGNAL(triggered()), this, SLOT(toggleRunStatus()));
 
@@ -432,6 +439,7 @@ void Debugger::synchronize() {
   config().debugger.loadDefaultSymbols = menu_misc_loadDefaultSymbols->isChecked();
   config().debugger.saveSymbols = menu_misc_saveSymbols->isChecked();
   config().debugger.showHClocks = menu_misc_showHClocks->isChecked();
+  SNES::profiler.enable(menu_misc_profiler->isChecked());
   
   // todo: factor in whether or not cartridge actually contains SA1/SuperFX
   SNES::debugger.step_cpu = application.debug && debugCPU->stepProcessor->isChecked();
@@ -462,6 +470,10 @@ void Debugger::clear() {
   console->setHtml("");
 }
 
+void Debugger::printProfile() {
+  echo(string() << "<pre>" << SNES::profiler.report() << "</pre>");
+}
+
 void Debugger::switchWindow() {
   // give focus to the main window if needed so that emulation can continue
   if(config().input.focusPolicy == Configuration::Input::FocusPolicyPauseEmulation) {
@@ -19,6 +19,8 @@ public:
   QAction *menu_misc_loadDefaultSymbols;
   QAction *menu_misc_saveSymbols;
   QAction *menu_misc_showHClocks;
+  QAction *menu_misc_profiler;
+  QAction *menu_misc_profileReport;
   QAction *menu_misc_options;
 
   QVBoxLayout *layout;
@@ -57,6 +59,7 @@ public:
 
 public slots:
   void clear();
+  void printProfile();
   void synchronize();
   void frameTick();
 
@@ -46,6 +46,7 @@ struct ToggleCheatSystem : HotkeyInput {
 struct CaptureScreenshot : HotkeyInput {
   void pressed() {
     //tell SNES::Interface to save a screenshot at the next video_refresh() event
+    SNES::video.present_join();
     interface.saveScreenshot = true;
   }
 
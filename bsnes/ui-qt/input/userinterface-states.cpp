@@ -4,7 +4,11 @@ namespace UserInterfaceStates {
 
 struct Rewind : HotkeyInput {
   void pressed() {
-    ::state.rewind();
+    ::state.setRewinding(true);
+  }
+
+  void released() {
+    ::state.setRewinding(false);
   }
 
   Rewind() : HotkeyInput("Rewind", "input.userInterface.states.rewind") {
@@ -1,7 +1,25 @@
 Interface interface;
 
 void Interface::video_extras(uint16_t *data, unsigned width, unsigned height) {
-    if (music.loaded()) music.render((uint16_t*)data, 1024, width, height);
+  if (music.loaded()) music.render((uint16_t*)data, 1024, width, height);
+
+  //anything that looks at emulation state belongs here: with the presentation
+  //thread enabled, video_refresh() runs while the next frame is emulated
+  wasmInterface.on_frame_present(data, 2048, width, height, SNES::ppu.interlace());
+  state.frame();
+
+  //frame counter
+  static signed frameCount = 0;
+  static time_t prev, curr;
+  frameCount++;
+
+  time(&curr);
+  if(curr != prev) {
+    framesUpdated = true;
+    framesExecuted = frameCount;
+    frameCount = 0;
+    prev = curr;
+  }
 }
 
 void Interface::video_refresh(const uint16_t *data, unsigned width, unsigned height) {
@@ -22,11 +40,9 @@ void Interface::video_refresh(const uint16_t *data, unsigned width, unsigned hei
     if(!overscan) data -= 7 * 1024;
   }
 
-  data = wasmInterface.on_frame_present(data, pitch, width, height, interlace);
-
-  if(saveScreenshot == true && config().video.unfilteredScreenshot == true) {
-    captureScreenshot(filter.render_unfiltered(data, pitch, width, height));
-  }
+  QImage screenshot;
+  bool unfilteredScreenshot = saveScreenshot == true && config().video.unfilteredScreenshot == true;
+  if(unfilteredScreenshot) screenshot = filter.render_unfiltered(data, pitch, width, height);
 
   //scale display.crop* values from percentage-based (0-100%) to exact pixel sizes (width, height)
   unsigned cropLeft = (double)display.cropLeft / 100.0 * width;
@@ -41,6 +57,25 @@ void Interface::video_refresh(const uint16_t *data, unsigned width, unsigned hei
   unsigned outwidth, outheight, outpitch;
   filter.size(outwidth, outheight, width, height);
 
+  if(SNES::video.get_present_thread()) {
+    //filter into a picture of our own; present() hands it to the video driver,
+    //which may only be used from the main thread
+    Picture &picture = *pictureBack;
+    picture.data.resize(outwidth * outheight);
+    picture.width = outwidth;
+    picture.height = outheight;
+    picture.screenshot = screenshot;
+    data += cropTop * (pitch >> 1) + cropLeft;
+    filter.render(picture.data.data(), outwidth * sizeof(uint32_t), data, pitch, width, height);
+
+    QMutexLocker lock(&pictureMutex);
+    std::swap(pictureBack, pictureReady);
+    pictureFresh = true;
+    return;
+  }
+
+  if(unfilteredScreenshot) captureScreenshot(screenshot);
+
   if(video.lock(output, outpitch, outwidth, outheight) == true) {
     data += cropTop * (pitch >> 1) + cropLeft;
     filter.render(output, outpitch, data, pitch, width, height);
@@ -51,21 +86,37 @@ void Interface::video_refresh(const uint16_t *data, unsigned width, unsigned hei
       captureScreenshot(QImage((const unsigned char*)output, outwidth, outheight, outpitch, QImage::Format_RGB32));
     }
   }
+}
 
-  state.frame();
+//draws the latest picture filtered by the presentation thread, if there is a new one
+void Interface::present() {
+  {
+    QMutexLocker lock(&pictureMutex);
+    if(!pictureFresh) return;
+    std::swap(pictureReady, pictureFront);
+    pictureFresh = false;
+  }
+  Picture &picture = *pictureFront;
 
-  //frame counter
-  static signed frameCount = 0;
-  static time_t prev, curr;
-  frameCount++;
+  uint32_t *output;
+  unsigned outpitch;
+  if(video.lock(output, outpitch, picture.width, picture.height) == true) {
+    for(unsigned y = 0; y < picture.height; y++) {
+      memcpy((uint8_t*)output + y * outpitch, &picture.data[y * picture.width], picture.width * sizeof(uint32_t));
+    }
+    video.unlock();
+    video.refresh();
 
-  time(&curr);
-  if(curr != prev) {
-    framesUpdated = true;
-    framesExecuted = frameCount;
-    frameCount = 0;
-    prev = curr;
+    if(saveScreenshot == true && config().video.unfilteredScreenshot == false) {
+      captureScreenshot(QImage((const unsigned char*)picture.data.data(), picture.width, picture.height,
+        picture.width * sizeof(uint32_t), QImage::Format_RGB32).copy());
+    }
+  }
+
+  if(saveScreenshot == true && config().video.unfilteredScreenshot == true && !picture.screenshot.isNull()) {
+    captureScreenshot(picture.screenshot);
   }
+  picture.screenshot = QImage();
 }
 
 void Interface::audio_sample(uint16_t left, uint16_t right) {
@@ -123,4 +174,8 @@ void Interface::captureSPC() {
 
 Interface::Interface() {
   saveScreenshot = false;
+  pictureBack = &pictures[0];
+  pictureReady = &pictures[1];
+  pictureFront = &pictures[2];
+  pictureFresh = false;
 }
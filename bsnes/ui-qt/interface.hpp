@@ -10,9 +10,21 @@ public:
   Interface();
   void captureScreenshot(const QImage&);
   void captureSPC();
+  void present();
   bool saveScreenshot;
   bool framesUpdated;
   unsigned framesExecuted;
+
+private:
+  //triple buffer between the presentation thread (back) and the main thread (front)
+  struct Picture {
+    std::vector<uint32_t> data;
+    unsigned width, height;
+    QImage screenshot;
+  } pictures[3];
+  Picture *pictureBack, *pictureReady, *pictureFront;
+  bool pictureFresh;
+  QMutex pictureMutex;
 };
 
 extern Interface interface;
@@ -249,6 +249,7 @@ void VideoSettingsWindow::gammaAdjust(int value) {
 void VideoSettingsWindow::scanlineAdjust(int value) {
   config().video.scanlineAdjust = value * 5;
   syncUi();
+  SNES::video.present_join();
   scanlineFilter.setIntensity(value * 5);
 }
 
@@ -260,24 +261,28 @@ void VideoSettingsWindow::gammaRampToggle(int state) {
 
 void VideoSettingsWindow::cropLeftAdjust(int state) {
   config().video.cropLeft = state;
+  SNES::video.present_join();
   if(config().video.context->multiplier != 8) display.cropLeft = state;
   syncUi();
 }
 
 void VideoSettingsWindow::cropTopAdjust(int state) {
   config().video.cropTop = state;
+  SNES::video.present_join();
   if(config().video.context->multiplier != 8) display.cropTop = state;
   syncUi();
 }
 
 void VideoSettingsWindow::cropRightAdjust(int state) {
   config().video.cropRight = state;
+  SNES::video.present_join();
   if(config().video.context->multiplier != 8) display.cropRight = state;
   syncUi();
 }
 
 void VideoSettingsWindow::cropBottomAdjust(int state) {
   config().video.cropBottom = state;
+  SNES::video.present_join();
   if(config().video.context->multiplier != 8) display.cropBottom = state;
   syncUi();
 }
@@ -304,6 +309,7 @@ void VideoSettingsWindow::assignShader(const string &filename) {
 }
 
 void VideoSettingsWindow::unfilteredScreenshotToggle(int state) {
+  SNES::video.present_join();
   config().video.unfilteredScreenshot = (state == Qt::Checked);
   syncUi();
 }
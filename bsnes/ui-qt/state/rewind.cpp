@@ -0,0 +1,180 @@
+void Rewind::allocate(unsigned bytes) {
+  if(bytes == bufferSize) return;
+  if(buffer) delete[] buffer;
+  buffer = bytes ? new uint8_t[bytes] : 0;
+  bufferSize = bytes;
+  reset();
+}
+
+void Rewind::reset() {
+  head = 0;
+  used = 0;
+  entries = 0;
+  currentSize = 0;
+}
+
+void Rewind::capture(const serializer &state) {
+  if(!buffer) return;
+  const uint8_t *data = state.data();
+  unsigned size = state.size();
+
+  if(currentSize == size) {
+    //the delta is symmetric: newer ^ delta = older
+    unsigned length = encode(current, data, size, scratch);
+    push(scratch, length);
+  } else {
+    //first capture, or the state size changed (eg new cartridge): start over
+    reset();
+    if(current) delete[] current;
+    if(scratch) delete[] scratch;
+    current = new uint8_t[size];
+    currentSize = size;
+    scratchSize = size * 2 + 64;  //worst case: alternating changed and unchanged bytes
+    scratch = new uint8_t[scratchSize];
+  }
+  memcpy(current, data, size);
+}
+
+bool Rewind::rewind(serializer &state) {
+  if(entries == 0) return false;
+
+  unsigned length = readLength((head + bufferSize - 4) % bufferSize);
+  unsigned start = (head + bufferSize - 4 - length) % bufferSize;
+  read(start, scratch, length);
+  head = (start + bufferSize - 4) % bufferSize;
+  used -= length + 8;
+  entries--;
+
+  if(decode(scratch, length, current, currentSize) == false) {
+    reset();
+    return false;
+  }
+  state = serializer(current, currentSize);
+  return true;
+}
+
+Rewind::Rewind() {
+  buffer = 0;
+  bufferSize = 0;
+  current = 0;
+  scratch = 0;
+  scratchSize = 0;
+  reset();
+}
+
+Rewind::~Rewind() {
+  if(buffer) delete[] buffer;
+  if(current) delete[] current;
+  if(scratch) delete[] scratch;
+}
+
+//
+
+//output is a sequence of (unchanged count, changed count, changed bytes ^ previous)
+//runs, with counts stored as 7-bit varints. trailing unchanged bytes are implied.
+unsigned Rewind::encode(const uint8_t *prev, const uint8_t *next, unsigned size, uint8_t *output) const {
+  uint8_t *p = output;
+  unsigned offset = 0;
+
+  while(offset < size) {
+    unsigned start = offset;
+    while(offset + 8 <= size) {
+      uint64_t a, b;
+      memcpy(&a, prev + offset, 8);
+      memcpy(&b, next + offset, 8);
+      if(a != b) break;
+      offset += 8;
+    }
+    while(offset < size && prev[offset] == next[offset]) offset++;
+    if(offset == size) break;
+    unsigned skip = offset - start;
+
+    //short unchanged gaps are cheaper to store inline than as a new run
+    start = offset;
+    unsigned same = 0;
+    while(offset < size && same < 4) {
+      same = prev[offset] == next[offset] ? same + 1 : 0;
+      offset++;
+    }
+    offset -= same;
+    unsigned count = offset - start;
+
+    do { *p++ = (skip & 0x7f) | (skip > 0x7f ? 0x80 : 0); skip >>= 7; } while(skip);
+    do { *p++ = (count & 0x7f) | (count > 0x7f ? 0x80 : 0); count >>= 7; } while(count);
+    for(unsigned i = start; i < offset; i++) *p++ = prev[i] ^ next[i];
+  }
+
+  return p - output;
+}
+
+bool Rewind::decode(const uint8_t *input, unsigned length, uint8_t *target, unsigned size) const {
+  const uint8_t *end = input + length;
+  unsigned offset = 0;
+
+  while(input < end) {
+    unsigned skip = 0, count = 0;
+    for(unsigned shift = 0; input < end; shift += 7) {
+      skip |= (*input & 0x7f) << shift;
+      if(!(*input++ & 0x80)) break;
+    }
+    for(unsigned shift = 0; input < end; shift += 7) {
+      count |= (*input & 0x7f) << shift;
+      if(!(*input++ & 0x80)) break;
+    }
+    offset += skip;
+    if(offset + count > size || input + count > end) return false;
+    for(unsigned i = 0; i < count; i++) target[offset++] ^= *input++;
+  }
+
+  return true;
+}
+
+//ring entries are stored as [length][delta][length], so they can be removed
+//from the front (oldest) as well as from the back (newest)
+void Rewind::push(const uint8_t *data, unsigned length) {
+  unsigned total = length + 8;
+  if(total > bufferSize) {
+    //delta alone exceeds the budget: older history is no longer reachable
+    head = 0;
+    used = 0;
+    entries = 0;
+    return;
+  }
+  while(used + total > bufferSize) evict();
+
+  writeLength(head, length);
+  write((head + 4) % bufferSize, data, length);
+  writeLength((head + 4 + length) % bufferSize, length);
+  head = (head + total) % bufferSize;
+  used += total;
+  entries++;
+}
+
+void Rewind::evict() {
+  unsigned tail = (head + bufferSize - used) % bufferSize;
+  used -= readLength(tail) + 8;
+  entries--;
+}
+
+void Rewind::read(unsigned offset, uint8_t *data, unsigned length) const {
+  unsigned first = min(length, bufferSize - offset);
+  memcpy(data, buffer + offset, first);
+  memcpy(data + first, buffer, length - first);
+}
+
+void Rewind::write(unsigned offset, const uint8_t *data, unsigned length) {
+  unsigned first = min(length, bufferSize - offset);
+  memcpy(buffer + offset, data, first);
+  memcpy(buffer, data + first, length - first);
+}
+
+uint32_t Rewind::readLength(unsigned offset) const {
+  uint8_t data[4];
+  read(offset, data, 4);
+  return data[0] << 0 | data[1] << 8 | data[2] << 16 | data[3] << 24;
+}
+
+void Rewind::writeLength(unsigned offset, uint32_t length) {
+  uint8_t data[4] = { (uint8_t)(length >> 0), (uint8_t)(length >> 8), (uint8_t)(length >> 16), (uint8_t)(length >> 24) };
+  write(offset, data, 4);
+}
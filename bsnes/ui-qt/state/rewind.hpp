@@ -0,0 +1,40 @@
+//rewind history: keeps the most recent snapshot uncompressed, and every older
+//snapshot as the XOR difference to its successor, run-length encoded into a
+//fixed-size byte ring. the oldest deltas are discarded once the ring is full.
+class Rewind {
+public:
+  void allocate(unsigned bytes);
+  void reset();
+
+  void capture(const serializer &state);
+  bool rewind(serializer &state);
+
+  unsigned count() const { return entries; }
+  unsigned capacity() const { return bufferSize; }
+  unsigned usage() const { return used; }
+
+  Rewind();
+  ~Rewind();
+
+private:
+  uint8_t *buffer;
+  unsigned bufferSize;
+  unsigned head;     //write offset of the next delta
+  unsigned used;     //bytes occupied by stored deltas
+  unsigned entries;  //number of stored deltas
+
+  uint8_t *current;  //most recent snapshot
+  unsigned currentSize;
+  uint8_t *scratch;  //encode/decode workspace
+  unsigned scratchSize;
+
+  unsigned encode(const uint8_t *prev, const uint8_t *next, unsigned size, uint8_t *output) const;
+  bool decode(const uint8_t *input, unsigned length, uint8_t *target, unsigned size) const;
+
+  void push(const uint8_t *data, unsigned length);
+  void evict();
+  void read(unsigned offset, uint8_t *data, unsigned length) const;
+  void write(unsigned offset, const uint8_t *data, unsigned length);
+  uint32_t readLength(unsigned offset) const;
+  void writeLength(unsigned offset, uint32_t length);
+};
@@ -1,4 +1,6 @@
 #include "../ui-base.hpp"
+
+#include "rewind.cpp"
 State state;
 
 bool State::save(unsigned slot) {
@@ -53,23 +55,31 @@ bool State::load(unsigned slot) {
   return result;
 }
 
+//capture a snapshot every rewindInterval frames; while the rewind key is held,
+//step back one snapshot per frame instead
 void State::frame() {
   if(!allowed()) return;
   if(!config().system.rewindEnabled) return;
 
-  //if a full second has passed, automatically capture state
-  if(++frameCounter >= (SNES::system.region() == SNES::System::Region::NTSC ? 60 : 50)) {
-    frameCounter = 0;
-    historyIndex = (historyIndex + 1) % historySize;
-    historyCount = min(historyCount + 1, historySize);
-    SNES::system.runtosave();
-    history[historyIndex] = SNES::system.serialize();
+  if(rewinding) {
+    rewind();
+    return;
   }
+
+  if(++frameCounter < max(1U, config().system.rewindInterval)) return;
+  frameCounter = 0;
+
+  QElapsedTimer timer;
+  timer.start();
+  history.allocate(config().system.rewindMemory << 20);
+  SNES::system.runtosave();
+  history.capture(SNES::system.serialize());
+  unsigned elapsed = timer.nsecsElapsed() / 1000;
+  captureTime = captureTime ? (captureTime * 15 + elapsed) / 16 : elapsed;
 }
 
 void State::resetHistory() {
-  historyIndex = 0;
-  historyCount = 0;
+  history.reset();
   frameCounter = 0;
 }
 
@@ -77,23 +87,32 @@ bool State::rewind() {
   if(!allowed()) return false;
   if(!config().system.rewindEnabled) return false;
 
-  if(historyCount == 0) return false;
-  serializer state(history[historyIndex].data(), history[historyIndex].size());
-  bool result = SNES::system.unserialize(state);
-  historyIndex = (historyIndex + historySize - 1) % historySize;  //add historySize to prevent underflow
-  historyCount--;
-  return true;
+  serializer state;
+  if(history.rewind(state) == false) return false;
+  return SNES::system.unserialize(state);
 }
 
-State::State() {
-  active = 0;
-  historySize = 120;
-  history = new serializer[historySize];
-  for(unsigned i = 0; i < historySize; i++) history[i] = 0;
+void State::setRewinding(bool state) {
+  if(rewinding == state) return;
+  rewinding = state;
+  frameCounter = 0;
+
+  if(rewinding && allowed() && config().system.rewindEnabled) {
+    utility.showMessage(string()
+      << "Rewinding (" << history.count() << " snapshots, "
+      << (history.usage() >> 10) << "/" << (history.capacity() >> 10) << " KB, "
+      << captureTime << " us per capture)"
+    );
+    //step back immediately, so that a short press also works while paused
+    rewind();
+  }
 }
 
-State::~State() {
-  delete[] history;
+State::State() {
+  active = 0;
+  captureTime = 0;
+  frameCounter = 0;
+  rewinding = false;
 }
 
 //
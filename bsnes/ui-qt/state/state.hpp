@@ -1,3 +1,5 @@
+#include "rewind.hpp"
+
 class State {
 public:
   unsigned active;
@@ -7,16 +9,16 @@ public:
   void frame();
   void resetHistory();
   bool rewind();
+  void setRewinding(bool);
+
+  unsigned captureTime;  //average microseconds spent capturing one rewind snapshot
 
   State();
-  ~State();
 
 private:
-  serializer *history;
-  unsigned historySize;
-  unsigned historyIndex;
-  unsigned historyCount;
+  Rewind history;
   unsigned frameCounter;
+  bool rewinding;
 
   bool allowed() const;
   string name(unsigned slot) const;
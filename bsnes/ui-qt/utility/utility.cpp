@@ -68,6 +68,7 @@ void Utility::updateAvSync(bool syncVideo, bool syncAudio) {
 }
 
 void Utility::updateColorFilter() {
+  SNES::video.present_join();
   filter.contrast = config().video.contrastAdjust;
   filter.brightness = config().video.brightnessAdjust;
   filter.gamma = 100 + config().video.gammaAdjust;
@@ -86,6 +87,7 @@ void Utility::updateHardwareFilter() {
 }
 
 void Utility::updateSoftwareFilter() {
+  SNES::video.present_join();
   filter.renderer = config().video.context->swFilter;
 }
 
@@ -1,4 +1,6 @@
 void Utility::updateFullscreenState() {
+  //queued frames are presented with the settings of the context they were drawn for
+  SNES::video.present_join();
   if(config().video.isFullscreen == false) {
     config().video.context = &config().video.windowed;
     mainWindow->showNormal();
@@ -73,6 +75,7 @@ void Utility::resizeMainWindow() {
     }
   }
 
+  SNES::video.present_join();
   display.cropLeft = config().video.cropLeft;
   display.cropTop = config().video.cropTop;
   display.cropRight = config().video.cropRight;
@@ -147,6 +150,7 @@ void Utility::toggleSynchronizeAudio() {
 }
 
 void Utility::setNtscMode() {
+  SNES::video.present_join();
   config().video.context->region = 0;
   resizeMainWindow();
   mainWindow->shrink();
@@ -154,6 +158,7 @@ void Utility::setNtscMode() {
 }
 
 void Utility::setPalMode() {
+  SNES::video.present_join();
   config().video.context->region = 1;
   resizeMainWindow();
   mainWindow->shrink();
@@ -265,6 +265,12 @@ wasm_binding(ppux_vram_write, "i(ii*i)") {
   }
 
   memcpy(t + i_offset, i_data, i_size);
+  // local space is the console's own VRAM; mark the pages written for delta savestates
+  if (i_space == 0) {
+    for (uint32_t n = i_offset & ~(SNES::DirtyPages::PageSize - 1); n < i_offset + i_size; n += SNES::DirtyPages::PageSize) {
+      SNES::memory::vram.mark(n);
+    }
+  }
 
   wa_return(0);
 }
@@ -330,6 +336,12 @@ wasm_binding(ppux_cgram_write, "i(ii*i)") {
   }
 
   memcpy(t + i_offset, i_data, i_size);
+  // local space is the console's own CGRAM; mark the pages written for delta savestates
+  if (i_space == 0) {
+    for (uint32_t n = i_offset & ~(SNES::DirtyPages::PageSize - 1); n < i_offset + i_size; n += SNES::DirtyPages::PageSize) {
+      SNES::memory::cgram.mark(n);
+    }
+  }
 
   wa_return(0);
 }
@@ -346,7 +358,9 @@ wasm_binding(ppux_oam_write, "i(i*i)") {
 
   unsigned maxSize = 0;
   uint8_t *t = nullptr;
+#if !defined(PROFILE_ACCURACY)
   t = SNES::ppu.ppux_get_oam();
+#endif
   maxSize = 0x220;
   if (!t) {
     std::string err("OAM memory not allocated");
@@ -377,6 +391,10 @@ wasm_binding(ppux_oam_write, "i(i*i)") {
   }
 
   memcpy(t + i_offset, i_data, i_size);
+  // mark the OAM pages written for delta savestates
+  for (uint32_t n = i_offset & ~(SNES::DirtyPages::PageSize - 1); n < i_offset + i_size; n += SNES::DirtyPages::PageSize) {
+    SNES::memory::oam.mark(n);
+  }
 
   wa_return(0);
 }
@@ -523,7 +541,9 @@ wasm_binding(ppux_oam_read, "i(i*i)") {
 
   unsigned maxSize = 0;
   uint8_t *t = nullptr;
+#if !defined(PROFILE_ACCURACY)
   t = SNES::ppu.ppux_get_oam();
+#endif
   maxSize = 0x220;
   if (!t) {
     std::string err("OAM memory not allocated");
@@ -599,9 +619,13 @@ wasm_binding(snes_bus_write, "v(i*i)") {
   wa_success();
 }
 
+// the accuracy PPU has no ppux layer: draw lists are accepted and discarded there
+
 //void ppux_draw_list_clear();
 wasm_binding(ppux_draw_list_clear, "v()") {
+#if !defined(PROFILE_ACCURACY)
   SNES::ppu.ppux_modules[m_index].draw_lists.clear();
+#endif
 
   wa_success();
 }
@@ -610,7 +634,9 @@ wasm_binding(ppux_draw_list_clear, "v()") {
 wasm_binding(ppux_draw_list_resize, "v(i)") {
   wa_arg    (uint32_t,  i_len);
 
+#if !defined(PROFILE_ACCURACY)
   SNES::ppu.ppux_modules[m_index].draw_lists.resize(i_len);
+#endif
 
   wa_success();
 }
@@ -628,6 +654,9 @@ wasm_binding(ppux_draw_list_set, "i(ii*)") {
     wa_check_mem(i_cmdlist, i_len * sizeof(uint16_t));
   }
 
+#if defined(PROFILE_ACCURACY)
+  wa_return(i_index);
+#else
   auto &draw_lists = SNES::ppu.ppux_modules[m_index].draw_lists;
   if (i_index >= draw_lists.size()) {
     report_error(WASMError("ppux_draw_list_set", "index out of bounds of draw_lists vector"));
@@ -645,6 +674,7 @@ wasm_binding(ppux_draw_list_set, "i(ii*)") {
   }
 
   wa_return(i_index);
+#endif
 }
 
 //uint32_t ppux_draw_list_append(uint32_t i_len, uint16_t* i_cmdlist);
@@ -659,6 +689,9 @@ wasm_binding(ppux_draw_list_append, "i(i*)") {
     wa_check_mem(i_cmdlist, i_len * sizeof(uint16_t));
   }
 
+#if defined(PROFILE_ACCURACY)
+  wa_return(0);
+#else
   // extend draw_lists vector:
   auto &draw_lists = SNES::ppu.ppux_modules[m_index].draw_lists;
   int n = draw_lists.size();
@@ -675,6 +708,7 @@ wasm_binding(ppux_draw_list_append, "i(i*)") {
   }
 
   wa_return(n);
+#endif
 }
 
 #undef wasm_binding
@@ -163,7 +163,9 @@ const uint16_t *WASMInterface::on_frame_present(const uint16_t *data, unsigned p
 
 void WASMInterface::reset() {
   m_instances.clear();
+#if !defined(PROFILE_ACCURACY)
   SNES::ppu.ppux_modules.clear();
+#endif
   log_message(L_INFO, "all wasm modules removed");
 }
 
@@ -196,12 +198,14 @@ bool WASMInterface::load_zip(const std::string &instanceKey, const uint8_t *data
 
   m->m_index = (it - m_instances.begin());
   m_instances.emplace(it, m);
+#if !defined(PROFILE_ACCURACY)
   SNES::ppu.ppux_modules.emplace(
     SNES::ppu.ppux_modules.begin() + m->m_index,
     instanceKey,
     m->m_fonts,
     m->m_spaces
   );
+#endif
 
   log_module_message(L_INFO, instanceKey, {"wasm module loaded from zip into slot ", std::to_string(m->m_index)});
 
@@ -228,7 +232,9 @@ void WASMInterface::unload_zip(const std::string &instanceKey) {
     return;
 
   m_instances.erase(it);
+#if !defined(PROFILE_ACCURACY)
   SNES::ppu.ppux_modules.erase(SNES::ppu.ppux_modules.begin() + (it - m_instances.begin()));
+#endif
 
   // update m_index of successive instances:
   for (; it != m_instances.end(); it++) {
@@ -73,37 +73,49 @@ namespace nall {
       for(unsigned n = 0; n < size; n++) integer(array[n]);
     }
 
+    //byte arrays (memory images) need no per-element conversion
+    void array(uint8_t *array, unsigned size) {
+      if(imode == Save) {
+        memcpy(idata + isize, array, size);
+      } else if(imode == Load) {
+        memcpy(array, idata + isize, size);
+      }
+      isize += size;
+    }
+
     //copy
     serializer& operator=(const serializer &s) {
-      if(idata) delete[] idata;
+      if(idata && iowner) delete[] idata;
 
       imode = s.imode;
       idata = new uint8_t[s.icapacity];
       isize = s.isize;
       icapacity = s.icapacity;
+      iowner = true;
 
       memcpy(idata, s.idata, s.icapacity);
       return *this;
     }
 
-    serializer(const serializer &s) : idata(0) {
+    serializer(const serializer &s) : idata(0), iowner(false) {
       operator=(s);
     }
 
     //move
     serializer& operator=(serializer &&s) {
-      if(idata) delete[] idata;
+      if(idata && iowner) delete[] idata;
 
       imode = s.imode;
       idata = s.idata;
       isize = s.isize;
       icapacity = s.icapacity;
+      iowner = s.iowner;
 
       s.idata = 0;
       return *this;
     }
 
-    serializer(serializer &&s) {
+    serializer(serializer &&s) : idata(0), iowner(false) {
       operator=(std::move(s));
     }
 
@@ -113,6 +125,7 @@ namespace nall {
       idata = 0;
       isize = 0;
       icapacity = 0;
+      iowner = true;
     }
 
     serializer(unsigned capacity) {
@@ -120,6 +133,7 @@ namespace nall {
       idata = new uint8_t[capacity]();
       isize = 0;
       icapacity = capacity;
+      iowner = true;
     }
 
     serializer(const uint8_t *data, unsigned capacity) {
@@ -127,11 +141,22 @@ namespace nall {
       idata = new uint8_t[capacity];
       isize = 0;
       icapacity = capacity;
+      iowner = true;
       memcpy(idata, data, capacity);
     }
 
+    //wraps a caller-owned buffer without allocating or copying it: Save writes
+    //into the buffer, Load reads from it. the buffer must outlive the serializer.
+    serializer(mode_t mode, uint8_t *data, unsigned capacity) {
+      imode = mode;
+      idata = data;
+      isize = 0;
+      icapacity = capacity;
+      iowner = false;
+    }
+
     ~serializer() {
-      if(idata) delete[] idata;
+      if(idata && iowner) delete[] idata;
     }
 
   private:
@@ -139,6 +164,7 @@ namespace nall {
     uint8_t *idata;
     unsigned isize;
     unsigned icapacity;
+    bool iowner;
   };
 
 };
@@ -0,0 +1,72 @@
+#ifndef NALL_SPSCRING_HPP
+#define NALL_SPSCRING_HPP
+
+#include <atomic>
+#include <string.h>
+#include <nall/algorithm.hpp>
+#include <nall/bit.hpp>
+
+namespace nall {
+  //single-producer, single-consumer ring buffer: one thread may push while another
+  //pops, without locks. items are copied with memcpy, so T must be trivially copyable.
+  //resize() and reset() may only be called while neither side is in use.
+  template<typename T> class spsc_ring {
+  public:
+    unsigned capacity() const { return size; }
+    unsigned count() const { return wroffset.load(std::memory_order_acquire) - rdoffset.load(std::memory_order_acquire); }
+
+    //copies up to length items in, and returns how many fit
+    unsigned push(const T *data, unsigned length) {
+      unsigned wr = wroffset.load(std::memory_order_relaxed);
+      unsigned rd = rdoffset.load(std::memory_order_acquire);
+      length = min(length, size - (wr - rd));
+      unsigned first = min(length, size - (wr & mask));
+      memcpy(buffer + (wr & mask), data, first * sizeof(T));
+      memcpy(buffer, data + first, (length - first) * sizeof(T));
+      wroffset.store(wr + length, std::memory_order_release);
+      return length;
+    }
+
+    //copies up to length items out, and returns how many there were
+    unsigned pop(T *data, unsigned length) {
+      unsigned rd = rdoffset.load(std::memory_order_relaxed);
+      unsigned wr = wroffset.load(std::memory_order_acquire);
+      length = min(length, wr - rd);
+      unsigned first = min(length, size - (rd & mask));
+      memcpy(data, buffer + (rd & mask), first * sizeof(T));
+      memcpy(data + first, buffer, (length - first) * sizeof(T));
+      rdoffset.store(rd + length, std::memory_order_release);
+      return length;
+    }
+
+    void reset() {
+      rdoffset.store(0, std::memory_order_relaxed);
+      wroffset.store(0, std::memory_order_relaxed);
+    }
+
+    //capacity is rounded up to a power of two
+    void resize(unsigned capacity) {
+      capacity = bit::round(max(capacity, 1U));
+      if(capacity != size) {
+        delete[] buffer;
+        buffer = new T[capacity];
+        size = capacity;
+        mask = capacity - 1;
+      }
+      reset();
+    }
+
+    spsc_ring() : buffer(0), size(0), mask(0), rdoffset(0), wroffset(0) {}
+    ~spsc_ring() { delete[] buffer; }
+
+  private:
+    T *buffer;
+    unsigned size, mask;
+    std::atomic<unsigned> rdoffset, wroffset;  //free-running; wrap via mask
+
+    spsc_ring(const spsc_ring&);
+    spsc_ring& operator=(const spsc_ring&);
+  };
+}
+
+#endif